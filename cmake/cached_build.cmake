@@ -0,0 +1,142 @@
+###############################################################################
+### Cached build of the report or fpga target of one sample
+###############################################################################
+# cmake -DSAMPLE=<name> -DSOURCE_DIR=<sample> -DBINARY_DIR=<build tree>
+#       -DBUILD_TARGET=<report|fpga> -DOUTPUT_NAME=<name.target>
+#       -DCACHE_DIR=<cache> -DKEY_EXTRA=<board and flags>
+#       -P cached_build.cmake
+#
+# The key is the SHA256 of the sources of the sample (src*/, relative path
+# and content), its CMakeLists and KEY_EXTRA. When CACHE_DIR/SAMPLE/BUILD_TARGET/
+# <key> holds the outputs, they are copied to BINARY_DIR and nothing is
+# built. Otherwise the target is built and its outputs are stored under the
+# key: OUTPUT_NAME and OUTPUT_NAME.prj, which holds the reports, for the
+# report target, only the OUTPUT_NAME image for the fpga target as its
+# .prj is the Quartus project of the full compile, several GB per key.
+#
+# For the fpga target, the last image built is kept in CACHE_DIR/SAMPLE/
+# fpga/latest and, on a cache miss, copied in SOURCE_DIR/fpga_image before
+# the build: the -reuse-exe flag of the sample points there, so the
+# compiler only redoes the device compilation if the device code differs
+# from that image. This is the only write to the source tree, and it
+# overwrites the image left there by a previous build.
+#
+# The report and fpga targets of a sample share BINARY_DIR, so they must
+# not run at the same time: the superproject builds fpga after report.
+#
+# A sample with a src/device directory separates host and device code
+# (see code/30-device_link): its kernels are built into a device image by
+# the fpga_image target, <name>.fpga_image.a, and the fpga target only
+# links the host code against it. The key of the report and of the device
+# image then only covers src/device and the CMakeLists, the image is
+# cached under CACHE_DIR/SAMPLE/fpga_image, and the host link is always
+# redone since it takes minutes.
+foreach(var SAMPLE SOURCE_DIR BINARY_DIR BUILD_TARGET OUTPUT_NAME CACHE_DIR)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "cached_build.cmake: ${var} is not set")
+    endif()
+endforeach()
+
+if(IS_DIRECTORY ${SOURCE_DIR}/src/device)
+    set(KEY_DIRS src/device)
+else()
+    set(KEY_DIRS src*)
+endif()
+set(KEY_GLOBS )
+foreach(dir ${KEY_DIRS})
+    foreach(ext cpp hpp h cc)
+        list(APPEND KEY_GLOBS ${SOURCE_DIR}/${dir}/*.${ext})
+    endforeach()
+endforeach()
+file(GLOB_RECURSE KEY_FILES RELATIVE ${SOURCE_DIR} ${KEY_GLOBS})
+list(SORT KEY_FILES)
+
+# Sets ENTRY to the cache entry of target
+function(cache_entry target)
+    set(key_text "${target} ${KEY_EXTRA}\n")
+    foreach(file CMakeLists.txt ${KEY_FILES})
+        file(SHA256 ${SOURCE_DIR}/${file} file_hash)
+        string(APPEND key_text "${file} ${file_hash}\n")
+    endforeach()
+    string(SHA256 key "${key_text}")
+    set(ENTRY ${CACHE_DIR}/${SAMPLE}/${target}/${key} PARENT_SCOPE)
+endfunction()
+
+# Copies the outputs found in entry to BINARY_DIR, sets RESTORED
+function(restore entry outputs)
+    set(RESTORED FALSE PARENT_SCOPE)
+    foreach(output ${outputs})
+        if(EXISTS ${entry}/${output})
+            file(COPY ${entry}/${output} DESTINATION ${BINARY_DIR})
+            # newer than the sources, so that make does not rebuild it
+            if(NOT IS_DIRECTORY ${BINARY_DIR}/${output})
+                file(TOUCH_NOCREATE ${BINARY_DIR}/${output})
+            endif()
+            set(RESTORED TRUE PARENT_SCOPE)
+        endif()
+    endforeach()
+endfunction()
+
+# Stored next to the entry then renamed, an interrupted copy is never a hit
+function(store entry outputs)
+    file(REMOVE_RECURSE ${entry}.tmp)
+    file(MAKE_DIRECTORY ${entry}.tmp)
+    foreach(output ${outputs})
+        if(EXISTS ${BINARY_DIR}/${output})
+            file(COPY ${BINARY_DIR}/${output} DESTINATION ${entry}.tmp)
+        endif()
+    endforeach()
+    file(REMOVE_RECURSE ${entry})
+    file(RENAME ${entry}.tmp ${entry})
+endfunction()
+
+function(build target)
+    execute_process(COMMAND ${CMAKE_COMMAND} --build ${BINARY_DIR} --target ${target}
+                    RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "${SAMPLE} ${target}: build failed")
+    endif()
+endfunction()
+
+if(KEY_DIRS STREQUAL "src/device" AND BUILD_TARGET STREQUAL "fpga")
+    get_filename_component(NAME ${OUTPUT_NAME} NAME_WE)
+    set(IMAGE ${NAME}.fpga_image.a)
+    cache_entry(fpga_image)
+    restore(${ENTRY} ${IMAGE})
+    if(RESTORED)
+        message(STATUS "${SAMPLE} fpga_image: unchanged device sources, restored from ${ENTRY}")
+    else()
+        build(fpga_image)
+        store(${ENTRY} ${IMAGE})
+        message(STATUS "${SAMPLE} fpga_image: stored in ${ENTRY}")
+    endif()
+    build(fpga)
+    return()
+endif()
+
+cache_entry(${BUILD_TARGET})
+if(BUILD_TARGET STREQUAL "report")
+    set(OUTPUTS ${OUTPUT_NAME} ${OUTPUT_NAME}.prj)
+else()
+    set(OUTPUTS ${OUTPUT_NAME})
+endif()
+
+restore(${ENTRY} "${OUTPUTS}")
+if(RESTORED)
+    message(STATUS "${SAMPLE} ${BUILD_TARGET}: unchanged sources, restored from ${ENTRY}")
+    return()
+endif()
+
+if(BUILD_TARGET STREQUAL "fpga" AND EXISTS ${CACHE_DIR}/${SAMPLE}/fpga/latest/${OUTPUT_NAME})
+    message(STATUS "${SAMPLE} fpga: device code of the last image offered for reuse")
+    file(COPY ${CACHE_DIR}/${SAMPLE}/fpga/latest/${OUTPUT_NAME} DESTINATION ${SOURCE_DIR}/fpga_image)
+endif()
+
+build(${BUILD_TARGET})
+
+store(${ENTRY} "${OUTPUTS}")
+if(BUILD_TARGET STREQUAL "fpga" AND EXISTS ${BINARY_DIR}/${OUTPUT_NAME})
+    file(REMOVE_RECURSE ${CACHE_DIR}/${SAMPLE}/fpga/latest)
+    file(COPY ${BINARY_DIR}/${OUTPUT_NAME} DESTINATION ${CACHE_DIR}/${SAMPLE}/fpga/latest)
+endif()
+message(STATUS "${SAMPLE} ${BUILD_TARGET}: stored in ${ENTRY}")
@@ -16,6 +16,8 @@ export I_MPI_OFI_PROVIDER=verbs
 export JEMALLOC_PRELOAD=$(jemalloc-config --libdir)/libjemalloc.so.$(jemalloc-config --revision)
 EXE="./fpga_image/mpi_fpga_pi.fpga"
 srun --mpi=pspmi --export=ALL,LD_PRELOAD=${JEMALLOC_PRELOAD} $EXE
+# One rank per node driving every FPGA card of the node
+#srun --mpi=pspmi --export=ALL,LD_PRELOAD=${JEMALLOC_PRELOAD} $EXE --multi-device
 
 
 
@@ -2,9 +2,13 @@
 // oneAPI headers
 #include <sycl/ext/intel/fpga_extensions.hpp>
 #include <sycl/sycl.hpp>
+#include <algorithm>
+#include <cctype>
 #include <iomanip>  // setprecision library
 #include <iostream>
 #include <numeric> 
+#include <string>
+#include <vector>
 
 
 using namespace sycl;
@@ -43,6 +47,84 @@ void mpi_native(double* results, int rank_num, int num_procs,
 }
 
 
+////////////////////////////////////////////////////////////////////////
+//
+// Build one in-order queue per device found on the platform of the
+// selected device. When the platform exposes fewer devices than requested
+// (e.g. the FPGA emulator), devices are reused round-robin so that the
+// multi-device path can still be tested.
+//
+////////////////////////////////////////////////////////////////////////
+template <typename Selector>
+std::vector<queue> make_device_queues(const Selector& selector,
+                                      int num_devices) {
+  device selected{selector};
+  std::vector<device> devices = selected.get_platform().get_devices();
+  if (devices.empty()) devices.push_back(selected);
+  if (num_devices <= 0) num_devices = devices.size();
+
+  property_list q_prop{property::queue::in_order(),
+                       property::queue::enable_profiling()};
+  std::vector<queue> queues;
+  for (int d = 0; d < num_devices; d++)
+    queues.emplace_back(devices[d % devices.size()], q_prop);
+  return queues;
+}
+
+////////////////////////////////////////////////////////////////////////
+//
+// Same computation as mpi_native, but the slice owned by the rank is
+// split across all the queues. Every device gets its own USM allocation
+// so the kernels are submitted back to back and run concurrently.
+// The kernel time of each device is printed once all of them completed.
+//
+////////////////////////////////////////////////////////////////////////
+void mpi_multi_device(double* results, int rank_num, int num_procs,
+                      long total_num_steps, std::vector<queue>& queues) {
+
+  double dx = 1.0f / (double)total_num_steps;
+  long items_per_proc = total_num_steps / size_t(num_procs);
+  long num_devices = queues.size();
+  long items_per_device = (items_per_proc + num_devices - 1) / num_devices;
+
+  std::vector<double*> device_results(num_devices, nullptr);
+  std::vector<event> kernel_events(num_devices);
+  std::vector<event> copy_events(num_devices);
+
+  for (long d = 0; d < num_devices; d++) {
+    long offset = d * items_per_device;
+    long count = std::min(items_per_device, items_per_proc - offset);
+    if (count <= 0) continue;
+    long first_step = rank_num * items_per_proc + offset;
+    double* out = malloc_device<double>(count, queues[d]);
+    device_results[d] = out;
+
+    kernel_events[d] = queues[d].submit([&](handler& h) {
+      h.parallel_for(range<1>(count), [=](id<1> k) {
+        double x = ((double)(first_step + k)) * dx;
+        out[k] = (4.0f * dx) / (1.0f + x * x);
+      });
+    });
+    // The queues are in-order: the copy starts once the kernel is done
+    copy_events[d] = queues[d].memcpy(results + offset, out,
+                                      count * sizeof(double));
+  }
+
+  for (long d = 0; d < num_devices; d++) {
+    if (device_results[d] == nullptr) continue;
+    copy_events[d].wait();
+    double start = kernel_events[d].get_profiling_info<info::event_profiling::command_start>();
+    double end = kernel_events[d].get_profiling_info<info::event_profiling::command_end>();
+    long count = std::min(items_per_device, items_per_proc - d * items_per_device);
+    std::cout << "Rank #" << rank_num << " device #" << d << " ("
+              << queues[d].get_device().get_info<info::device::name>()
+              << "): " << count << " steps, kernel time "
+              << (end - start) * 1e-6 << " ms\n";
+    free(device_results[d], queues[d]);
+  }
+}
+
+
 int main(int argc, char** argv) {
   long num_steps = 1000000;
   char machine_name[MPI_MAX_PROCESSOR_NAME];
@@ -66,15 +148,37 @@ int main(int argc, char** argv) {
   auto selector = sycl::cpu_selector_v;
   #endif
 
-  property_list q_prop{property::queue::in_order()};
-  queue myQueue{selector,q_prop};
-
   // Start MPI.
   if (MPI_Init(&argc, &argv) != MPI_SUCCESS) {
     std::cout << "Failed to initialize MPI\n";
     exit(-1);
   }
 
+  // --multi-device [N]: the rank drives N devices (all of them by default)
+  bool multi_device = false;
+  int num_devices = 0;
+  for (int i = 1; i < argc; i++) {
+    std::string option(argv[i]);
+    if (option == "--multi-device") {
+      multi_device = true;
+      if (i + 1 < argc && std::isdigit(argv[i + 1][0]))
+        num_devices = std::stoi(argv[++i]);
+    } else if (option == "-h" || option == "--help") {
+      std::cout << "Usage: \n<executable> [--multi-device [N]]\n";
+      MPI_Finalize();
+      return 1;
+    }
+  }
+
+  // A single queue in single-device mode, so that no context is opened on
+  // a device that is not used
+  property_list q_prop{property::queue::in_order()};
+  std::vector<queue> queues;
+  if (multi_device)
+    queues = make_device_queues(selector, num_devices);
+  else
+    queues.emplace_back(selector, q_prop);
+
   // Create the communicator, and retrieve the number of MPI ranks.
   MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
 
@@ -86,9 +190,14 @@ int main(int argc, char** argv) {
 
   if(id == master) t1 = MPI_Wtime();
 
-  std::cout << "Rank #" << id << " runs on: " << machine_name
-            << ", uses device: "
-            << myQueue.get_device().get_info<info::device::name>() << "\n";
+  if (multi_device) {
+    std::cout << "Rank #" << id << " runs on: " << machine_name
+              << ", uses " << queues.size() << " devices\n";
+  } else {
+    std::cout << "Rank #" << id << " runs on: " << machine_name
+              << ", uses device: "
+              << queues.front().get_device().get_info<info::device::name>() << "\n";
+  }
 
   int num_step_per_rank = num_steps / num_procs;
   double* results_per_rank = new double[num_step_per_rank];
@@ -97,7 +206,10 @@ int main(int argc, char** argv) {
   for (size_t i = 0; i < num_step_per_rank; i++) results_per_rank[i] = 0.0;
 
   // Calculate the Pi number partially by multiple MPI ranks.
-  mpi_native(results_per_rank, id, num_procs, num_steps, myQueue);
+  if (multi_device)
+    mpi_multi_device(results_per_rank, id, num_procs, num_steps, queues);
+  else
+    mpi_native(results_per_rank, id, num_procs, num_steps, queues.front());
 
   double local_sum = 0.0;
   for(unsigned int i = 0; i < num_step_per_rank; i++){
@@ -0,0 +1,177 @@
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+#include "partitioner.hpp"
+
+// Forward declare the kernel name in the global scope. This is an FPGA best
+// practice that reduces name mangling in the optimization reports.
+class Scale1DID;
+class Scale2DID;
+
+constexpr int kIterations = 4;
+
+// Print how the last run was spread over the devices
+void report(const char* name, int it, Partitioner& p) {
+  for (size_t d = 0; d < p.size(); d++) {
+    std::cout << name << " it " << it << " device #" << d << ": "
+              << p.items()[d] << " items, "
+              << std::fixed << std::setprecision(3)
+              << p.seconds()[d] * 1e3 << " ms, "
+              << p.throughput(d) / 1e6 << " Mitems/s, next weight "
+              << p.weights()[d] << "\n";
+  }
+}
+
+int main(int argc, char* argv[]) {
+#if defined(FPGA_SIMULATOR)
+  size_t rows = 1 << 4;
+#else
+  size_t rows = 1 << 12;
+#endif
+  size_t cols = 1024;
+  int num_devices = 0;
+
+  for (int i = 1; i < argc; i++) {
+    std::string option(argv[i]);
+    if (option == "--devices" && i + 1 < argc) {
+      num_devices = std::stoi(argv[++i]);
+    } else if (option == "--rows" && i + 1 < argc) {
+      rows = std::stoul(argv[++i]);
+    } else {
+      std::cout << "Usage: \n<executable> [--devices N] [--rows R]\n\nFAILED\n";
+      return 1;
+    }
+  }
+  const size_t n = rows * cols;
+
+  bool passed = true;
+  try {
+    // Use compile-time macros to select either:
+    //  - the FPGA emulator device (CPU emulation of the FPGA)
+    //  - the FPGA device (a real FPGA)
+    //  - the simulator device
+#if FPGA_SIMULATOR
+    auto selector = sycl::ext::intel::fpga_simulator_selector_v;
+#elif FPGA_HARDWARE
+    auto selector = sycl::ext::intel::fpga_selector_v;
+#else  // #if FPGA_EMULATOR
+    auto selector = sycl::ext::intel::fpga_emulator_selector_v;
+#endif
+
+    // One in-order queue per device of the platform. The emulator only
+    // exposes one device: it is reused so that several queues compete.
+    sycl::device selected{selector};
+    std::vector<sycl::device> devices = selected.get_platform().get_devices();
+    if (num_devices <= 0) num_devices = std::max<int>(2, devices.size());
+    std::vector<sycl::queue> queues;
+    for (int d = 0; d < num_devices; d++) {
+      queues.emplace_back(devices[d % devices.size()],
+                          sycl::property::queue::in_order());
+      std::cout << "Queue #" << d << " running on device: "
+                << queues.back().get_device().get_info<sycl::info::device::name>()
+                << std::endl;
+    }
+
+    float* host_in = new (std::align_val_t{64}) float[n];
+    float* host_out = new (std::align_val_t{64}) float[n];
+    for (size_t i = 0; i < n; i++) host_in[i] = static_cast<float>(i % 1000);
+
+    // Every device gets a full size copy so that any piece can land on it
+    std::vector<float*> device_in(queues.size());
+    std::vector<float*> device_out(queues.size());
+    for (size_t d = 0; d < queues.size(); d++) {
+      device_in[d] = sycl::malloc_device<float>(n, queues[d]);
+      device_out[d] = sycl::malloc_device<float>(n, queues[d]);
+    }
+
+    Partitioner partitioner(queues);
+
+    // 1-D: out[i] = 2 * in[i] + 1
+    auto launch_1d = [&](sycl::queue& q, size_t d, size_t offset,
+                         size_t count) {
+      float* in = device_in[d] + offset;
+      float* out = device_out[d] + offset;
+      q.memcpy(in, host_in + offset, count * sizeof(float));
+      q.submit([&](sycl::handler& h) {
+        h.single_task<Scale1DID>([=]() [[intel::kernel_args_restrict]] {
+          for (size_t i = 0; i < count; i++) out[i] = 2.0f * in[i] + 1.0f;
+        });
+      });
+      return q.memcpy(host_out + offset, out, count * sizeof(float));
+    };
+
+    // 2-D: out[r][c] = in[r][c] + r, on a band of rows
+    auto launch_2d = [&](sycl::queue& q, size_t d, sycl::id<2> offset,
+                         sycl::range<2> extent) {
+      size_t first = offset[0] * cols;
+      size_t count = extent.size();
+      float* in = device_in[d] + first;
+      float* out = device_out[d] + first;
+      size_t row0 = offset[0];
+      q.memcpy(in, host_in + first, count * sizeof(float));
+      q.submit([&](sycl::handler& h) {
+        h.parallel_for<Scale2DID>(extent, [=](sycl::id<2> idx) {
+          out[idx[0] * cols + idx[1]] =
+              in[idx[0] * cols + idx[1]] + static_cast<float>(row0 + idx[0]);
+        });
+      });
+      return q.memcpy(host_out + first, out, count * sizeof(float));
+    };
+
+    // Static split, rebalanced after every iteration
+    for (int it = 0; it < kIterations; it++) {
+      partitioner.run(n, Policy::Static, launch_1d);
+      report("static 1-D", it, partitioner);
+    }
+    for (size_t i = 0; i < n && passed; i++) {
+      if (host_out[i] != 2.0f * host_in[i] + 1.0f) {
+        std::cout << "1-D idx=" << i << ": result " << host_out[i]
+                  << ", expected " << 2.0f * host_in[i] + 1.0f << std::endl;
+        passed = false;
+      }
+    }
+
+    // Work-stealing chunks of rows
+    for (int it = 0; it < kIterations; it++) {
+      partitioner.run_2d(rows, cols, Policy::Dynamic, launch_2d);
+      report("dynamic 2-D", it, partitioner);
+    }
+    for (size_t i = 0; i < n && passed; i++) {
+      float expected = host_in[i] + static_cast<float>(i / cols);
+      if (host_out[i] != expected) {
+        std::cout << "2-D idx=" << i << ": result " << host_out[i]
+                  << ", expected " << expected << std::endl;
+        passed = false;
+      }
+    }
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+
+    for (size_t d = 0; d < queues.size(); d++) {
+      sycl::free(device_in[d], queues[d]);
+      sycl::free(device_out[d], queues[d]);
+    }
+    delete[] host_in;
+    delete[] host_out;
+  } catch (sycl::exception const &e) {
+    // Catches exceptions in the host code.
+    std::cerr << "Caught a SYCL host exception:\n" << e.what() << "\n";
+
+    // Most likely the runtime couldn't find FPGA hardware!
+    if (e.code().value() == CL_DEVICE_NOT_FOUND) {
+      std::cerr << "If you are targeting an FPGA, please ensure that your "
+                   "system has a correctly configured FPGA board.\n";
+      std::cerr << "Run sys_check in the oneAPI root directory to verify.\n";
+      std::cerr << "If you are targeting the FPGA emulator, compile with "
+                   "-DFPGA_EMULATOR.\n";
+    }
+    std::terminate();
+  }
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
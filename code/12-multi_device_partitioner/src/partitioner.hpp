@@ -0,0 +1,148 @@
+#ifndef PARTITIONER_HPP
+#define PARTITIONER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+// oneAPI headers
+#include <sycl/sycl.hpp>
+
+////////////////////////////////////////////////////////////////////////
+//
+// Split a 1-D or 2-D index space across any number of queues.
+//
+// The user provides a launcher called as launch(q, d, offset, count) which
+// submits the work for [offset, offset+count) on q, the queue number d
+// (copy in, kernel, copy out), and returns the last event. The 2-D
+// version splits along the rows and calls launch(q, d, id<2> offset,
+// range<2> extent).
+//
+//  - Static:  one contiguous piece per queue, sized with the weights of
+//             the queues. After each run the weights are updated with the
+//             measured throughput so that the next run is rebalanced.
+//  - Dynamic: the index space is cut in chunks and every queue picks the
+//             next free chunk as soon as its previous one is done
+//             (work-stealing), so faster devices simply process more.
+//
+// Each queue is driven by its own host thread so that all the devices
+// are busy at the same time.
+//
+////////////////////////////////////////////////////////////////////////
+
+enum class Policy { Static, Dynamic };
+
+class Partitioner {
+ public:
+  explicit Partitioner(std::vector<sycl::queue> queues)
+      : queues_(std::move(queues)),
+        weights_(queues_.size(), 1.0 / queues_.size()),
+        items_(queues_.size(), 0),
+        seconds_(queues_.size(), 0.0) {}
+
+  template <typename Launch>
+  void run(size_t n, Policy policy, Launch launch, size_t chunk = 0) {
+    std::fill(items_.begin(), items_.end(), 0);
+    std::fill(seconds_.begin(), seconds_.end(), 0.0);
+    if (policy == Policy::Static)
+      run_static(n, launch);
+    else
+      run_dynamic(n, launch, chunk > 0 ? chunk : default_chunk(n));
+    if (policy == Policy::Static) rebalance();
+  }
+
+  template <typename Launch>
+  void run_2d(size_t rows, size_t cols, Policy policy, Launch launch,
+              size_t chunk_rows = 0) {
+    // rows are contiguous in memory, so the pieces are bands of full rows
+    auto launch_rows = [&](sycl::queue& q, size_t d, size_t row, size_t count) {
+      return launch(q, d, sycl::id<2>(row, 0), sycl::range<2>(count, cols));
+    };
+    run(rows, policy, launch_rows, chunk_rows);
+  }
+
+  size_t size() const { return queues_.size(); }
+  sycl::queue& get_queue(size_t d) { return queues_[d]; }
+  const std::vector<double>& weights() const { return weights_; }
+  const std::vector<size_t>& items() const { return items_; }
+  const std::vector<double>& seconds() const { return seconds_; }
+
+  // Items per second processed by device d during the last run
+  double throughput(size_t d) const {
+    return seconds_[d] > 0.0 ? items_[d] / seconds_[d] : 0.0;
+  }
+
+ private:
+  using clock = std::chrono::steady_clock;
+
+  size_t default_chunk(size_t n) const {
+    // a few chunks per device leaves room to compensate imbalance
+    return std::max<size_t>(1, n / (8 * queues_.size()));
+  }
+
+  template <typename Launch>
+  void run_static(size_t n, Launch& launch) {
+    std::vector<size_t> offsets(queues_.size() + 1, 0);
+    for (size_t d = 0; d < queues_.size(); d++)
+      offsets[d + 1] =
+          std::min(n, offsets[d] + static_cast<size_t>(weights_[d] * n));
+    // the last device takes the rounding leftovers
+    offsets.back() = n;
+
+    std::vector<std::thread> workers;
+    for (size_t d = 0; d < queues_.size(); d++) {
+      workers.emplace_back([&, d]() {
+        size_t count = offsets[d + 1] - offsets[d];
+        if (count == 0) return;
+        auto start = clock::now();
+        launch(queues_[d], d, offsets[d], count).wait();
+        seconds_[d] = std::chrono::duration<double>(clock::now() - start).count();
+        items_[d] = count;
+      });
+    }
+    for (auto& w : workers) w.join();
+  }
+
+  template <typename Launch>
+  void run_dynamic(size_t n, Launch& launch, size_t chunk) {
+    std::atomic<size_t> next{0};
+    std::vector<std::thread> workers;
+    for (size_t d = 0; d < queues_.size(); d++) {
+      workers.emplace_back([&, d]() {
+        auto start = clock::now();
+        size_t offset;
+        while ((offset = next.fetch_add(chunk)) < n) {
+          size_t count = std::min(chunk, n - offset);
+          launch(queues_[d], d, offset, count).wait();
+          items_[d] += count;
+        }
+        seconds_[d] = std::chrono::duration<double>(clock::now() - start).count();
+      });
+    }
+    for (auto& w : workers) w.join();
+  }
+
+  // New weights are proportional to the measured throughput. A minimum
+  // weight keeps every device busy so that it is measured again next run.
+  void rebalance() {
+    std::vector<double> rates(queues_.size());
+    for (size_t d = 0; d < queues_.size(); d++) rates[d] = throughput(d);
+    double total = std::accumulate(rates.begin(), rates.end(), 0.0);
+    if (total <= 0.0) return;
+    double min_weight = 0.01 / queues_.size();
+    for (size_t d = 0; d < queues_.size(); d++)
+      weights_[d] = std::max(min_weight, rates[d] / total);
+    total = std::accumulate(weights_.begin(), weights_.end(), 0.0);
+    for (auto& w : weights_) w /= total;
+  }
+
+  std::vector<sycl::queue> queues_;
+  std::vector<double> weights_;
+  std::vector<size_t> items_;
+  std::vector<double> seconds_;
+};
+
+#endif
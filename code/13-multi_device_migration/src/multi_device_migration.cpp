@@ -0,0 +1,226 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+// Forward declare the kernel name in the global scope. This is an FPGA best
+// practice that reduces name mangling in the optimization reports.
+class ProducerID;
+class ConsumerID;
+
+#define ALIGNMENT 64
+
+constexpr int kRepetitions = 5;
+// Size of the pinned staging buffers used to pipeline host transfers
+constexpr size_t kChunkBytes = 4 << 20;
+
+using clock_type = std::chrono::steady_clock;
+
+////////////////////////////////////////////////////////////////////////
+//
+// Device to device migration paths between two device USM allocations
+// living in the same context:
+//  - Peer:        direct copy, only if the runtime exposes peer access
+//  - PinnedHost:  staged through two pinned host USM buffers, the copy
+//                 out of the source of chunk i+1 overlaps the copy into
+//                 the destination of chunk i
+//  - HostArray:   full round trip through a plain host array, which is
+//                 what E09 does with its two halves
+//
+////////////////////////////////////////////////////////////////////////
+enum class Path { Peer, PinnedHost, HostArray };
+
+const char* path_name(Path p) {
+  switch (p) {
+    case Path::Peer: return "peer";
+    case Path::PinnedHost: return "pinned host (staged)";
+    default: return "host array (round trip)";
+  }
+}
+
+bool enable_peer_access(sycl::queue& src, sycl::queue& dst) {
+  try {
+    auto src_dev = src.get_device();
+    auto dst_dev = dst.get_device();
+    if (src_dev == dst_dev) return false;
+    if (!dst_dev.ext_oneapi_can_access_peer(
+            src_dev, sycl::ext::oneapi::peer_access::access_supported))
+      return false;
+    dst_dev.ext_oneapi_enable_peer_access(src_dev);
+    return true;
+  } catch (sycl::exception const&) {
+    // The backend does not implement the peer access extension
+    return false;
+  }
+}
+
+sycl::event migrate(Path path, sycl::queue& src_q, sycl::queue& dst_q,
+                    char* dst, const char* src, size_t bytes,
+                    char* staging[2], char* host_array) {
+  switch (path) {
+    case Path::Peer:
+      return dst_q.memcpy(dst, src, bytes);
+
+    case Path::PinnedHost: {
+      sycl::event up[2];
+      sycl::event last;
+      for (size_t off = 0, i = 0; off < bytes; off += kChunkBytes, i++) {
+        size_t len = std::min(kChunkBytes, bytes - off);
+        char* stage = staging[i % 2];
+        // the staging buffer is free once its previous upload is done
+        sycl::event down = src_q.memcpy(stage, src + off, len, up[i % 2]);
+        up[i % 2] = dst_q.memcpy(dst + off, stage, len, down);
+        last = up[i % 2];
+      }
+      up[0].wait();
+      up[1].wait();
+      return last;
+    }
+
+    default:
+      src_q.memcpy(host_array, src, bytes).wait();
+      return dst_q.memcpy(dst, host_array, bytes);
+  }
+}
+
+int main(int argc, char* argv[]) {
+#if defined(FPGA_SIMULATOR)
+  size_t max_bytes = 1 << 16;
+#else
+  size_t max_bytes = 256 << 20;
+#endif
+
+  if (argc > 1) {
+    std::string option(argv[1]);
+    if (option == "-h" || option == "--help") {
+      std::cout << "Usage: \n<executable> <max size in bytes>\n\nFAILED\n";
+      return 1;
+    } else {
+      max_bytes = std::stoul(option);
+    }
+  }
+
+  bool passed = true;
+  try {
+    // Use compile-time macros to select either:
+    //  - the FPGA emulator device (CPU emulation of the FPGA)
+    //  - the FPGA device (a real FPGA)
+    //  - the simulator device
+#if FPGA_SIMULATOR
+    auto selector = sycl::ext::intel::fpga_simulator_selector_v;
+#elif FPGA_HARDWARE
+    auto selector = sycl::ext::intel::fpga_selector_v;
+#else  // #if FPGA_EMULATOR
+    auto selector = sycl::ext::intel::fpga_emulator_selector_v;
+#endif
+
+    // All the devices must share the same context so that a USM pointer
+    // of one card can be used in a copy submitted to the other one. The
+    // emulator exposes a single device: both queues then target it.
+    sycl::device selected{selector};
+    std::vector<sycl::device> devices = selected.get_platform().get_devices();
+    sycl::context ctx(devices);
+    sycl::device dev0 = devices[0];
+    sycl::device dev1 = devices[devices.size() > 1 ? 1 : 0];
+    sycl::property_list q_prop{sycl::property::queue::in_order()};
+    sycl::queue q0(ctx, dev0, q_prop);
+    sycl::queue q1(ctx, dev1, q_prop);
+
+    std::cout << "Source device: "
+              << dev0.get_info<sycl::info::device::name>() << std::endl;
+    std::cout << "Destination device: "
+              << dev1.get_info<sycl::info::device::name>() << std::endl;
+
+    bool peer = enable_peer_access(q0, q1);
+    std::cout << "Peer access: " << (peer ? "available" : "not available")
+              << std::endl;
+
+    char* src = static_cast<char*>(
+        sycl::aligned_alloc_device(ALIGNMENT, max_bytes, dev0, ctx));
+    char* dst = static_cast<char*>(
+        sycl::aligned_alloc_device(ALIGNMENT, max_bytes, dev1, ctx));
+    char* staging[2] = {
+        static_cast<char*>(sycl::aligned_alloc_host(ALIGNMENT, kChunkBytes, ctx)),
+        static_cast<char*>(sycl::aligned_alloc_host(ALIGNMENT, kChunkBytes, ctx))};
+    char* host_array = new (std::align_val_t{ALIGNMENT}) char[max_bytes];
+
+    // Pipeline of two boards: the first one produces, the second consumes
+    const size_t n = max_bytes / sizeof(int);
+    int* produced = reinterpret_cast<int*>(src);
+    int* consumed = reinterpret_cast<int*>(dst);
+    q0.submit([&](sycl::handler& h) {
+      h.single_task<ProducerID>([=]() {
+        for (size_t i = 0; i < n; i++) produced[i] = static_cast<int>(i);
+      });
+    }).wait();
+
+    std::vector<Path> paths = {Path::PinnedHost, Path::HostArray};
+    if (peer) paths.insert(paths.begin(), Path::Peer);
+
+    std::cout << std::setw(26) << "path" << std::setw(14) << "bytes"
+              << std::setw(12) << "GB/s" << std::endl;
+    for (Path path : paths) {
+      for (size_t bytes = 4096; bytes <= max_bytes; bytes *= 4) {
+        double best = 1e30;
+        for (int r = 0; r < kRepetitions; r++) {
+          auto start = clock_type::now();
+          migrate(path, q0, q1, dst, src, bytes, staging, host_array).wait();
+          double t = std::chrono::duration<double>(clock_type::now() - start).count();
+          best = std::min(best, t);
+        }
+        std::cout << std::setw(26) << path_name(path) << std::setw(14) << bytes
+                  << std::setw(12) << std::fixed << std::setprecision(3)
+                  << bytes / best * 1e-9 << std::endl;
+      }
+
+      // the consumer checks that the whole array arrived on the second board
+      migrate(path, q0, q1, dst, src, n * sizeof(int), staging, host_array).wait();
+      int errors = 0;
+      int* errors_dev = sycl::malloc_device<int>(1, q1);
+      q1.submit([&](sycl::handler& h) {
+        h.single_task<ConsumerID>([=]() {
+          int count = 0;
+          for (size_t i = 0; i < n; i++)
+            count += (consumed[i] != static_cast<int>(i));
+          *errors_dev = count;
+        });
+      }).wait();
+      q1.memcpy(&errors, errors_dev, sizeof(int)).wait();
+      sycl::free(errors_dev, q1);
+      q1.memset(dst, 0, max_bytes).wait();
+      if (errors != 0) {
+        std::cout << path_name(path) << ": " << errors << " wrong values"
+                  << std::endl;
+        passed = false;
+      }
+    }
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+
+    sycl::free(src, ctx);
+    sycl::free(dst, ctx);
+    sycl::free(staging[0], ctx);
+    sycl::free(staging[1], ctx);
+    delete[] host_array;
+  } catch (sycl::exception const &e) {
+    // Catches exceptions in the host code.
+    std::cerr << "Caught a SYCL host exception:\n" << e.what() << "\n";
+
+    // Most likely the runtime couldn't find FPGA hardware!
+    if (e.code().value() == CL_DEVICE_NOT_FOUND) {
+      std::cerr << "If you are targeting an FPGA, please ensure that your "
+                   "system has a correctly configured FPGA board.\n";
+      std::cerr << "Run sys_check in the oneAPI root directory to verify.\n";
+      std::cerr << "If you are targeting the FPGA emulator, compile with "
+                   "-DFPGA_EMULATOR.\n";
+    }
+    std::terminate();
+  }
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,349 @@
+#ifndef BATCH_HPP
+#define BATCH_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+// oneAPI headers
+#include <sycl/sycl.hpp>
+
+#include "convolution.hpp"
+
+////////////////////////////////////////////////////////////////////////
+//
+// Batch mode: convolve a directory (or a list file) of images with a
+// single queue and a single device image.
+//
+//   decode (pool) -> [ready queue] -> device -> [done queue] -> encode (pool)
+//
+// The decode threads read and convert images ahead of the device. The
+// ready queue is bounded so that decoding never runs too far ahead and
+// the memory stays bounded. The device stage keeps two images in flight
+// so that the transfers of one image overlap the kernel of the other.
+// The encode threads convert the results back to 8-bit and write them.
+//
+// The first image decoded, or every image with verify_all, is
+// checked against reference_convolution before it is written. Images
+// whose file names collide in output_dir are written as <index>_<name>.
+// The kernel utilization comes from the profiling of the kernel events;
+// the queue must have the enable_profiling property. threads and depth
+// must be at least 1, and the batch fails when no image could be written.
+//
+////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+class BoundedQueue {
+ public:
+  explicit BoundedQueue(size_t capacity) : capacity_(capacity) {}
+
+  void push(T item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(lock, [&]() { return items_.size() < capacity_; });
+    items_.push(std::move(item));
+    not_empty_.notify_one();
+  }
+
+  // Returns false once the queue is closed and drained
+  bool pop(T& item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [&]() { return !items_.empty() || closed_; });
+    if (items_.empty()) return false;
+    item = std::move(items_.front());
+    items_.pop();
+    not_full_.notify_one();
+    return true;
+  }
+
+  void close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    not_empty_.notify_all();
+  }
+
+ private:
+  size_t capacity_;
+  bool closed_ = false;
+  std::queue<T> items_;
+  std::mutex mutex_;
+  std::condition_variable not_full_;
+  std::condition_variable not_empty_;
+};
+
+struct BatchImage {
+  std::string name;
+  int rows = 0;
+  int cols = 0;
+  std::vector<float> pixels;
+  std::vector<float> input;  // copy of the input pixels, when checked
+};
+
+// Busy time of a stage, accumulated by all its threads
+class StageTimer {
+ public:
+  template <typename F>
+  auto measure(F f) {
+    auto start = std::chrono::steady_clock::now();
+    auto result = f();
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  std::chrono::steady_clock::now() - start).count();
+    busy_ns_ += ns;
+    return result;
+  }
+  double seconds() const { return busy_ns_ * 1e-9; }
+
+ private:
+  std::atomic<long long> busy_ns_{0};
+};
+
+// Compare a result with the host reference of its input
+inline bool matches_reference(const BatchImage& image, const Filter& filter) {
+  std::vector<float> expected(image.input.size());
+  reference_convolution(image.input.data(), expected.data(), image.rows,
+                        image.cols, filter);
+  for (size_t i = 0; i < expected.size(); i++) {
+    float tol = 1e-3f * std::max(1.0f, std::fabs(expected[i]));
+    if (std::fabs(image.pixels[i] - expected[i]) > tol) {
+      std::cerr << image.name << ": pixel (" << i / image.cols << ","
+                << i % image.cols << ") = " << image.pixels[i]
+                << ", expected " << expected[i] << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Output file names: the file name of each input, prefixed with its index
+// in the list when several inputs share it
+inline std::vector<std::string> output_names(const std::vector<std::string>& files) {
+  std::map<std::string, int> uses;
+  std::vector<std::string> names;
+  for (const std::string& file : files)
+    names.push_back(std::filesystem::path(file).filename().string());
+  for (const std::string& name : names) uses[name]++;
+  for (size_t i = 0; i < names.size(); i++) {
+    if (uses[names[i]] > 1) {
+      std::cerr << "Warning: " << files[i] << " shares its file name with "
+                << "another input, written as " << i << "_" << names[i]
+                << std::endl;
+      names[i] = std::to_string(i) + "_" + names[i];
+    }
+  }
+  return names;
+}
+
+// Images of a directory, or the paths listed one per line in a file
+inline std::vector<std::string> list_images(const std::string& path) {
+  namespace fs = std::filesystem;
+  std::vector<std::string> files;
+  if (fs::is_directory(path)) {
+    const std::vector<std::string> extensions = {".png", ".jpg", ".jpeg", ".bmp",
+                                                 ".tif", ".tiff", ".pgm"};
+    for (auto& entry : fs::directory_iterator(path)) {
+      std::string ext = entry.path().extension().string();
+      std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+      if (entry.is_regular_file() &&
+          std::find(extensions.begin(), extensions.end(), ext) != extensions.end())
+        files.push_back(entry.path().string());
+    }
+    std::sort(files.begin(), files.end());
+  } else {
+    std::ifstream list(path);
+    std::string line;
+    while (std::getline(list, line))
+      if (!line.empty()) files.push_back(line);
+  }
+  return files;
+}
+
+inline bool convolve_batch(sycl::queue& q, const std::string& input,
+                           const std::string& output_dir, int threads,
+                           int depth, const Filter& filter, bool verify_all) {
+  std::vector<std::string> files = list_images(input);
+  if (files.empty()) {
+    std::cerr << "No image found in " << input << std::endl;
+    return false;
+  }
+  const std::vector<std::string> names = output_names(files);
+  std::error_code error;
+  std::filesystem::create_directories(output_dir, error);
+  if (error) {
+    std::cerr << "Cannot create " << output_dir << ": " << error.message()
+              << std::endl;
+    return false;
+  }
+
+  BoundedQueue<BatchImage> ready(depth);
+  BoundedQueue<BatchImage> done(depth);
+  StageTimer decode_timer, device_timer, encode_timer;
+  std::atomic<size_t> next_file{0};
+  std::atomic<int> skipped{0};
+  std::atomic<int> written{0};
+  std::atomic<int> failed{0};
+  std::atomic<bool> first_checked{false};
+  std::atomic<int> checked{0};
+  std::atomic<int> mismatches{0};
+  std::atomic<long long> kernel_ns{0};
+
+  auto start = std::chrono::steady_clock::now();
+
+  // decode pool
+  std::vector<std::thread> decoders;
+  for (int t = 0; t < threads; t++) {
+    decoders.emplace_back([&]() {
+      size_t i;
+      while ((i = next_file++) < files.size()) {
+        BatchImage image = decode_timer.measure([&]() {
+          BatchImage img;
+          img.name = names[i];
+          cv::Mat gray = cv::imread(files[i], cv::IMREAD_GRAYSCALE);
+          if (gray.empty() || gray.cols + kRadius > kMaxCols) return img;
+          cv::Mat pixels;
+          gray.convertTo(pixels, CV_32F);
+          img.rows = pixels.rows;
+          img.cols = pixels.cols;
+          img.pixels.assign(pixels.ptr<float>(), pixels.ptr<float>() + pixels.total());
+          if (verify_all || !first_checked.exchange(true)) img.input = img.pixels;
+          return img;
+        });
+        if (image.rows == 0) {
+          std::cerr << "Skipping " << files[i] << std::endl;
+          skipped++;
+          continue;
+        }
+        ready.push(std::move(image));
+      }
+    });
+  }
+  std::thread close_ready([&]() {
+    for (auto& t : decoders) t.join();
+    ready.close();
+  });
+
+  // encode pool
+  std::vector<std::thread> encoders;
+  for (int t = 0; t < threads; t++) {
+    encoders.emplace_back([&]() {
+      BatchImage image;
+      while (done.pop(image)) {
+        if (!image.input.empty()) {
+          checked++;
+          if (!matches_reference(image, filter)) mismatches++;
+        }
+        bool ok = encode_timer.measure([&]() {
+          cv::Mat result(image.rows, image.cols, CV_32F, image.pixels.data());
+          cv::Mat gray;
+          result.convertTo(gray, CV_8U);
+          return cv::imwrite(output_dir + "/" + image.name, gray);
+        });
+        if (ok) {
+          written++;
+        } else {
+          std::cerr << "Could not write " << output_dir << "/" << image.name
+                    << std::endl;
+          failed++;
+        }
+      }
+    });
+  }
+
+  // device stage: two images in flight, buffers grow with the largest image
+  struct InFlight {
+    BatchImage image;
+    float* device_in = nullptr;
+    float* device_out = nullptr;
+    size_t capacity = 0;
+    sycl::event kernel;
+    sycl::event done;
+    bool busy = false;
+  } slots[2];
+
+  auto retire = [&](InFlight& s) {
+    if (!s.busy) return;
+    device_timer.measure([&]() {
+      s.done.wait();
+      return 0;
+    });
+    kernel_ns += static_cast<long long>(
+        s.kernel.get_profiling_info<sycl::info::event_profiling::command_end>() -
+        s.kernel.get_profiling_info<sycl::info::event_profiling::command_start>());
+    s.busy = false;
+    done.push(std::move(s.image));
+  };
+
+  BatchImage image;
+  int count = 0;
+  while (ready.pop(image)) {
+    InFlight& s = slots[count % 2];
+    retire(s);
+    device_timer.measure([&]() {
+      size_t pixels = image.pixels.size();
+      if (pixels > s.capacity) {
+        if (s.device_in) sycl::free(s.device_in, q);
+        if (s.device_out) sycl::free(s.device_out, q);
+        s.device_in = sycl::malloc_device<float>(pixels, q);
+        s.device_out = sycl::malloc_device<float>(pixels, q);
+        s.capacity = pixels;
+      }
+      s.image = std::move(image);
+      float* host = s.image.pixels.data();
+      sycl::event copy_in = q.memcpy(s.device_in, host, pixels * sizeof(float));
+      s.kernel =
+          filter.separable
+              ? line_buffer_convolution<true>(q, s.device_in, s.device_out,
+                                              s.image.rows, s.image.cols, filter, {copy_in})
+              : line_buffer_convolution<false>(q, s.device_in, s.device_out,
+                                               s.image.rows, s.image.cols, filter, {copy_in});
+      // the result overwrites the input pixels, which are not needed anymore
+      s.done = q.memcpy(host, s.device_out, pixels * sizeof(float), s.kernel);
+      s.busy = true;
+      return 0;
+    });
+    count++;
+  }
+  retire(slots[count % 2]);
+  retire(slots[(count + 1) % 2]);
+  done.close();
+
+  close_ready.join();
+  for (auto& t : encoders) t.join();
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  for (auto& s : slots) {
+    if (s.device_in) sycl::free(s.device_in, q);
+    if (s.device_out) sycl::free(s.device_out, q);
+  }
+
+  std::cout << "Batch: " << written << " images written to " << output_dir
+            << ", " << skipped << " skipped, " << failed << " not written"
+            << std::endl;
+  std::cout << "Batch: " << checked << " images checked against the reference, "
+            << mismatches << " mismatches" << std::endl;
+  std::cout << "Batch: " << std::fixed << std::setprecision(3) << seconds
+            << " s, " << written / seconds << " images/s" << std::endl;
+  std::cout << "Utilization: decode "
+            << 100.0 * decode_timer.seconds() / (seconds * threads)
+            << "%, device submit/wait (host) "
+            << 100.0 * device_timer.seconds() / seconds << "%, encode "
+            << 100.0 * encode_timer.seconds() / (seconds * threads) << "%"
+            << std::endl;
+  std::cout << "Utilization: kernel (profiling) "
+            << 100.0 * kernel_ns * 1e-9 / seconds << "%" << std::endl;
+  return failed == 0 && mismatches == 0 && written > 0 &&
+         written + skipped == static_cast<int>(files.size());
+}
+
+#endif
@@ -0,0 +1,241 @@
+#ifndef CONVOLUTION_HPP
+#define CONVOLUTION_HPP
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+// The datapath is built for the largest supported filter. Smaller filters
+// (3x3, 5x5) are centred in the 7x7 window with zero taps around them, so
+// the kernel size is a runtime parameter and one bitstream serves all.
+constexpr int kMaxKernelSize = 7;
+constexpr int kRadius = kMaxKernelSize / 2;
+// Widest image row held in the on-chip line buffers (halo included)
+constexpr int kMaxCols = 8192;
+
+struct Filter {
+  int size;
+  bool separable;
+  // Full taps, row-major kMaxKernelSize x kMaxKernelSize
+  float taps[kMaxKernelSize * kMaxKernelSize];
+  // taps[r][c] == vert[r] * horiz[c] when the filter is separable
+  float vert[kMaxKernelSize];
+  float horiz[kMaxKernelSize];
+};
+
+// Forward declare the kernel names in the global scope. This is an FPGA best
+// practice that reduces name mangling in the optimization reports.
+template <bool kSeparable> class LineBufferConvID;
+class NaiveConvID;
+
+////////////////////////////////////////////////////////////////////////
+//
+// Filter construction. Every filter is applied as a correlation:
+// out(y,x) = sum taps[r][c] * in(y - kRadius + r, x - kRadius + c)
+// and pixels outside the image are zero.
+//
+////////////////////////////////////////////////////////////////////////
+
+// Rank-1 factorization of the taps, sets f.separable on success
+inline void factor_separable(Filter& f) {
+  constexpr int K = kMaxKernelSize;
+  int pr = 0, pc = 0;
+  for (int i = 0; i < K * K; i++)
+    if (std::fabs(f.taps[i]) > std::fabs(f.taps[pr * K + pc])) {
+      pr = i / K;
+      pc = i % K;
+    }
+  float pivot = f.taps[pr * K + pc];
+  f.separable = false;
+  if (pivot == 0.0f) return;
+  for (int r = 0; r < K; r++) f.vert[r] = f.taps[r * K + pc];
+  for (int c = 0; c < K; c++) f.horiz[c] = f.taps[pr * K + c] / pivot;
+  for (int r = 0; r < K; r++)
+    for (int c = 0; c < K; c++)
+      if (std::fabs(f.vert[r] * f.horiz[c] - f.taps[r * K + c]) > 1e-6f)
+        return;
+  f.separable = true;
+}
+
+// laplacian, gaussian (binomial) or box filter of size 3, 5 or 7
+inline bool make_filter(const std::string& name, int size, Filter& f) {
+  constexpr int K = kMaxKernelSize;
+  if (size != 3 && size != 5 && size != 7) return false;
+  f = Filter{};
+  f.size = size;
+  int o = (K - size) / 2;
+
+  if (name == "laplacian" && size == 3) {
+    // the 4-neighbour stencil of E10
+    for (int r = 0; r < 3; r++)
+      for (int c = 0; c < 3; c++)
+        f.taps[(o + r) * K + o + c] = ((r + c) % 2) ? 1.0f : 0.0f;
+    f.taps[kRadius * K + kRadius] = -4.0f;
+  } else if (name == "laplacian") {
+    for (int r = 0; r < size; r++)
+      for (int c = 0; c < size; c++) f.taps[(o + r) * K + o + c] = -1.0f;
+    f.taps[kRadius * K + kRadius] = size * size - 1.0f;
+  } else if (name == "gaussian" || name == "box") {
+    float w[K] = {};
+    float sum = 0.0f;
+    for (int i = 0; i < size; i++) {
+      // binomial coefficients C(size-1, i)
+      float b = 1.0f;
+      for (int k = 0; k < i; k++) b = b * (size - 1 - k) / (k + 1);
+      w[i] = (name == "box") ? 1.0f : b;
+      sum += w[i];
+    }
+    for (int r = 0; r < size; r++)
+      for (int c = 0; c < size; c++)
+        f.taps[(o + r) * K + o + c] = w[r] * w[c] / (sum * sum);
+  } else {
+    return false;
+  }
+  factor_separable(f);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////
+//
+// Streaming convolution with line buffers.
+//
+// A single work-item walks over the image in raster order, padded with
+// kRadius extra rows and columns, and reads every pixel from global
+// memory exactly once. The kMaxKernelSize-1 previous rows are kept in
+// on-chip line buffers; together with the new pixel they form the column
+// entering the sliding window. The output pixel (y-kRadius, x-kRadius)
+// is complete once pixel (y, x) has been read.
+//
+// The separable version only keeps one vertical sum per column in a
+// shift register, which needs 2K multipliers instead of K*K.
+//
+////////////////////////////////////////////////////////////////////////
+template <bool kSeparable>
+sycl::event line_buffer_convolution(sycl::queue& q, const float* in,
+                                    float* out, int rows, int cols,
+                                    const Filter& filter,
+                                    const std::vector<sycl::event>& deps = {}) {
+  Filter f = filter;
+  return q.submit([&](sycl::handler& h) {
+    h.depends_on(deps);
+    h.single_task<LineBufferConvID<kSeparable>>([=]()
+                                                [[intel::kernel_args_restrict]] {
+      constexpr int K = kMaxKernelSize;
+      // line_buffer[r][x] holds pixel (y - K + 1 + r, x)
+      float line_buffer[K - 1][kMaxCols];
+      float window[K][K];
+      float vsum[K];
+
+      for (int x = 0; x < kMaxCols; x++) {
+        #pragma unroll
+        for (int r = 0; r < K - 1; r++) line_buffer[r][x] = 0.0f;
+      }
+      #pragma unroll
+      for (int r = 0; r < K; r++) {
+        vsum[r] = 0.0f;
+        #pragma unroll
+        for (int c = 0; c < K; c++) window[r][c] = 0.0f;
+      }
+
+      const int padded_cols = cols + kRadius;
+      const int total = (rows + kRadius) * padded_cols;
+      int y = 0;
+      int x = 0;
+      [[intel::initiation_interval(1)]]
+      for (int step = 0; step < total; step++) {
+        float pixel = (y < rows && x < cols) ? in[y * cols + x] : 0.0f;
+
+        // new column of the window, oldest row first
+        float column[K];
+        #pragma unroll
+        for (int r = 0; r < K - 1; r++) column[r] = line_buffer[r][x];
+        column[K - 1] = pixel;
+        #pragma unroll
+        for (int r = 0; r < K - 1; r++) line_buffer[r][x] = column[r + 1];
+
+        float sum = 0.0f;
+        if constexpr (kSeparable) {
+          float v = 0.0f;
+          #pragma unroll
+          for (int r = 0; r < K; r++) v += f.vert[r] * column[r];
+          #pragma unroll
+          for (int c = 0; c < K - 1; c++) vsum[c] = vsum[c + 1];
+          vsum[K - 1] = v;
+          #pragma unroll
+          for (int c = 0; c < K; c++) sum += f.horiz[c] * vsum[c];
+        } else {
+          #pragma unroll
+          for (int r = 0; r < K; r++) {
+            #pragma unroll
+            for (int c = 0; c < K - 1; c++) window[r][c] = window[r][c + 1];
+            window[r][K - 1] = column[r];
+          }
+          #pragma unroll
+          for (int r = 0; r < K; r++) {
+            #pragma unroll
+            for (int c = 0; c < K; c++) sum += f.taps[r * K + c] * window[r][c];
+          }
+        }
+
+        int oy = y - kRadius;
+        int ox = x - kRadius;
+        if (oy >= 0 && ox >= 0) out[oy * cols + ox] = sum;
+
+        if (++x == padded_cols) {
+          x = 0;
+          y++;
+        }
+      }
+    });
+  });
+}
+
+// Straightforward ND-range version: every work-item reads its whole
+// neighbourhood from global memory.
+inline sycl::event naive_convolution(sycl::queue& q, const float* in,
+                                     float* out, int rows, int cols,
+                                     const Filter& filter,
+                                     const std::vector<sycl::event>& deps = {}) {
+  Filter f = filter;
+  return q.parallel_for<NaiveConvID>(
+      sycl::range<2>(rows, cols), deps, [=](sycl::id<2> idx) {
+        constexpr int K = kMaxKernelSize;
+        int y = idx[0];
+        int x = idx[1];
+        int o = (K - f.size) / 2;
+        float sum = 0.0f;
+        for (int r = 0; r < f.size; r++) {
+          for (int c = 0; c < f.size; c++) {
+            int iy = y - kRadius + o + r;
+            int ix = x - kRadius + o + c;
+            if (iy >= 0 && iy < rows && ix >= 0 && ix < cols)
+              sum += f.taps[(o + r) * K + o + c] * in[iy * cols + ix];
+          }
+        }
+        out[y * cols + x] = sum;
+      });
+}
+
+// Host reference
+inline void reference_convolution(const float* in, float* out, int rows,
+                                  int cols, const Filter& f) {
+  constexpr int K = kMaxKernelSize;
+  for (int y = 0; y < rows; y++)
+    for (int x = 0; x < cols; x++) {
+      float sum = 0.0f;
+      for (int r = 0; r < K; r++)
+        for (int c = 0; c < K; c++) {
+          int iy = y - kRadius + r;
+          int ix = x - kRadius + c;
+          if (iy >= 0 && iy < rows && ix >= 0 && ix < cols)
+            sum += f.taps[r * K + c] * in[iy * cols + ix];
+        }
+      out[y * cols + x] = sum;
+    }
+}
+
+#endif
@@ -0,0 +1,444 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+#include "batch.hpp"
+#include "convolution.hpp"
+#include "convolution_u8.hpp"
+#include "image_io.hpp"
+#include "strip_io.hpp"
+
+#define ALIGNMENT 64
+
+// Kernel time in ms from the profiling information of the event
+double kernel_time(const sycl::event& e) {
+  double start = e.get_profiling_info<sycl::info::event_profiling::command_start>();
+  double end = e.get_profiling_info<sycl::info::event_profiling::command_end>();
+  return (end - start) * 1e-6;
+}
+
+bool check(const char* name, const float* result, const float* expected,
+           int rows, int cols) {
+  for (int i = 0; i < rows * cols; i++) {
+    float tol = 1e-3f * std::max(1.0f, std::fabs(expected[i]));
+    if (std::fabs(result[i] - expected[i]) > tol) {
+      std::cout << name << ": pixel (" << i / cols << "," << i % cols
+                << ") = " << result[i] << ", expected " << expected[i]
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Check an 8-bit result against the reference saturated to [0,255], to
+// one gray level
+bool check_saturated(const char* name, const float* result,
+                     const float* expected, int rows, int cols) {
+  for (int i = 0; i < rows * cols; i++) {
+    float v = std::nearbyint(expected[i]);
+    float ref = v < 0.0f ? 0.0f : (v > 255.0f ? 255.0f : v);
+    if (std::fabs(result[i] - ref) > 1.0f) {
+      std::cout << name << ": pixel (" << i / cols << "," << i % cols
+                << ") = " << result[i] << ", expected " << ref << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+void usage(const char* exe) {
+  std::cout << "Usage: \n" << exe
+            << " [--image <file>] [--filter laplacian|gaussian|box]"
+               " [--size 3|5|7] [--rows R] [--cols C] [--strips S]"
+               " [--batch <dir|list> [--output <dir>] [--threads T] [--depth D] [--verify]]"
+               "\n\nFAILED\n";
+}
+
+////////////////////////////////////////////////////////////////////////
+//
+// Strip mode for images larger than the host or device memory.
+//
+// The image is processed in horizontal strips of strip_rows rows, each
+// read with kRadius halo rows above and below so that the rows of the
+// strip see their real neighbours. Two slots of pinned host and device
+// buffers are used in turn: while the device convolves strip i, the host
+// writes the result of strip i-1 and reads strip i+1. The memory used is
+// bounded by the strip size, not by the image size.
+//
+// Only the pipelined loop is timed. The output is checked afterwards,
+// strip by strip, against the host reference of the input blocks.
+//
+////////////////////////////////////////////////////////////////////////
+struct Slot {
+  float* host_in;
+  float* host_out;
+  float* device_in;
+  float* device_out;
+  int first;        // first row of the strip
+  int count;        // rows in the strip
+  int block_first;  // first row read, halo included
+  int block_rows;   // rows read, halo included
+  sycl::event done;
+};
+
+bool convolve_strips(sycl::queue& q, const char* in_path, const char* out_path,
+                     int strip_rows, const Filter& filter) {
+  PgmReader reader;
+  if (!reader.open(in_path)) {
+    std::cerr << "Strip mode expects an 8-bit binary PGM image" << std::endl;
+    return false;
+  }
+  const int rows = reader.rows();
+  const int cols = reader.cols();
+  if (cols + kRadius > kMaxCols) {
+    std::cerr << "Images wider than " << kMaxCols - kRadius
+              << " columns do not fit in the line buffers" << std::endl;
+    return false;
+  }
+  PgmWriter writer;
+  if (!writer.open(out_path, rows, cols)) {
+    std::cerr << "Cannot write " << out_path << std::endl;
+    return false;
+  }
+
+  const size_t block_pixels = size_t(strip_rows + 2 * kRadius) * cols;
+  Slot slots[2];
+  for (Slot& s : slots) {
+    s.host_in = sycl::malloc_host<float>(block_pixels, q);
+    s.host_out = sycl::malloc_host<float>(block_pixels, q);
+    s.device_in = sycl::malloc_device<float>(block_pixels, q);
+    s.device_out = sycl::malloc_device<float>(block_pixels, q);
+  }
+
+  auto read_strip = [&](Slot& s, int i) {
+    s.first = i * strip_rows;
+    s.count = std::min(strip_rows, rows - s.first);
+    s.block_first = std::max(0, s.first - kRadius);
+    s.block_rows = std::min(rows, s.first + s.count + kRadius) - s.block_first;
+    reader.read_rows(s.block_first, s.block_rows, s.host_in);
+  };
+
+  auto submit_strip = [&](Slot& s) {
+    size_t bytes = size_t(s.block_rows) * cols * sizeof(float);
+    sycl::event copy_in = q.memcpy(s.device_in, s.host_in, bytes);
+    sycl::event kernel =
+        filter.separable
+            ? line_buffer_convolution<true>(q, s.device_in, s.device_out,
+                                            s.block_rows, cols, filter, {copy_in})
+            : line_buffer_convolution<false>(q, s.device_in, s.device_out,
+                                             s.block_rows, cols, filter, {copy_in});
+    s.done = q.memcpy(s.host_out, s.device_out, bytes, kernel);
+  };
+
+  auto write_strip = [&](Slot& s) {
+    s.done.wait();
+    size_t halo = size_t(s.first - s.block_first) * cols;
+    writer.write_rows(s.host_out + halo, s.count);
+  };
+
+  const int num_strips = (rows + strip_rows - 1) / strip_rows;
+  std::cout << "Strip mode: " << num_strips << " strips of " << strip_rows
+            << " rows, " << 8 * block_pixels * sizeof(float) / (1 << 20)
+            << " MiB of strip buffers" << std::endl;
+
+  auto start = std::chrono::steady_clock::now();
+  read_strip(slots[0], 0);
+  for (int i = 0; i < num_strips; i++) {
+    submit_strip(slots[i % 2]);
+    // overlap the host I/O with the strip running on the device
+    if (i > 0) write_strip(slots[(i - 1) % 2]);
+    if (i + 1 < num_strips) read_strip(slots[(i + 1) % 2], i + 1);
+  }
+  write_strip(slots[(num_strips - 1) % 2]);
+  bool written = writer.close();
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  std::cout << "Strip mode: " << std::fixed << std::setprecision(3)
+            << seconds * 1e3 << " ms, "
+            << double(rows) * cols / (seconds * 1e6) << " Mpixels/s"
+            << std::endl;
+
+  // the written 8-bit output against the reference of every input block
+  if (!written) std::cerr << "Cannot write " << out_path << std::endl;
+  PgmReader output;
+  bool passed = written && output.open(out_path);
+  std::vector<float> expected(block_pixels), result(block_pixels);
+  for (int i = 0; passed && i < num_strips; i++) {
+    Slot& s = slots[0];
+    read_strip(s, i);
+    reference_convolution(s.host_in, expected.data(), s.block_rows, cols, filter);
+    size_t halo = size_t(s.first - s.block_first) * cols;
+    output.read_rows(s.first, s.count, result.data());
+    passed = check_saturated("strip", result.data(), expected.data() + halo,
+                             s.count, cols);
+  }
+
+  for (Slot& s : slots) {
+    sycl::free(s.host_in, q);
+    sycl::free(s.host_out, q);
+    sycl::free(s.device_in, q);
+    sycl::free(s.device_out, q);
+  }
+  return passed;
+}
+
+// Write the synthetic test image row by row as a PGM file
+bool write_test_pgm(const char* path, int rows, int cols) {
+  PgmWriter writer;
+  if (!writer.open(path, rows, cols)) return false;
+  std::vector<float> row(cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) row[j] = test_pixel(i, j);
+    writer.write_rows(row.data(), 1);
+  }
+  return writer.close();
+}
+
+int main(int argc, char* argv[]) {
+  const char* filename = nullptr;
+  std::string filter_name = "laplacian";
+  int size = 3;
+  int strip_rows = 0;
+  const char* batch = nullptr;
+  std::string output_dir = "output";
+  int threads = std::max(1u, std::thread::hardware_concurrency() / 2);
+  int depth = 8;
+  bool verify_all = false;
+#if defined(FPGA_SIMULATOR)
+  int Nx = 16;
+  int Ny = 16;
+#else
+  int Nx = 2048;
+  int Ny = 2048;
+#endif
+
+  for (int i = 1; i < argc; i++) {
+    std::string option(argv[i]);
+    if (option == "--image" && i + 1 < argc) {
+      filename = argv[++i];
+    } else if (option == "--filter" && i + 1 < argc) {
+      filter_name = argv[++i];
+    } else if (option == "--size" && i + 1 < argc) {
+      size = std::stoi(argv[++i]);
+    } else if (option == "--rows" && i + 1 < argc) {
+      Nx = std::stoi(argv[++i]);
+    } else if (option == "--cols" && i + 1 < argc) {
+      Ny = std::stoi(argv[++i]);
+    } else if (option == "--strips" && i + 1 < argc) {
+      strip_rows = std::stoi(argv[++i]);
+    } else if (option == "--batch" && i + 1 < argc) {
+      batch = argv[++i];
+    } else if (option == "--output" && i + 1 < argc) {
+      output_dir = argv[++i];
+    } else if (option == "--threads" && i + 1 < argc) {
+      threads = std::stoi(argv[++i]);
+    } else if (option == "--depth" && i + 1 < argc) {
+      depth = std::stoi(argv[++i]);
+    } else if (option == "--verify") {
+      verify_all = true;
+    } else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  // the batch stages need at least one thread and one slot in each queue
+  if (threads < 1 || depth < 1) {
+    std::cerr << "--threads and --depth must be at least 1" << std::endl;
+    usage(argv[0]);
+    return 1;
+  }
+
+  Filter filter;
+  if (!make_filter(filter_name, size, filter)) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  if (strip_rows > 0 || batch != nullptr) {
+    if (strip_rows > 0 && filename == nullptr) {
+      filename = "input.pgm";
+      if (!write_test_pgm(filename, Nx, Ny)) {
+        std::cerr << "Cannot write " << filename << std::endl;
+        std::cout << "FAILED" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    bool passed = true;
+    try {
+#if FPGA_SIMULATOR
+      auto selector = sycl::ext::intel::fpga_simulator_selector_v;
+#elif FPGA_HARDWARE
+      auto selector = sycl::ext::intel::fpga_selector_v;
+#else  // #if FPGA_EMULATOR
+      auto selector = sycl::ext::intel::fpga_emulator_selector_v;
+#endif
+      sycl::queue q(selector, sycl::property::queue::enable_profiling{});
+      std::cout << "Running on device: "
+                << q.get_device().get_info<sycl::info::device::name>().c_str()
+                << std::endl;
+      if (batch != nullptr)
+        passed = convolve_batch(q, batch, output_dir, threads, depth, filter,
+                                verify_all);
+      else
+        passed = convolve_strips(q, filename, "output.pgm", strip_rows, filter);
+    } catch (sycl::exception const &e) {
+      std::cerr << "Caught a SYCL host exception:\n" << e.what() << "\n";
+      std::terminate();
+    }
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  float* image = filename ? load_image(filename, &Nx, &Ny) : make_test_image(Nx, Ny);
+  if (image == nullptr) return EXIT_FAILURE;
+  if (Ny + kRadius > kMaxCols) {
+    std::cerr << "Images wider than " << kMaxCols - kRadius
+              << " columns do not fit in the line buffers" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "The image has " << Nx << " rows and " << Ny << " cols"
+            << std::endl;
+  std::cout << "Filter " << filter_name << " " << size << "x" << size
+            << (filter.separable ? " (separable)" : "") << std::endl;
+
+  const size_t pixels = size_t(Nx) * Ny;
+  float* expected = new float[pixels];
+  float* result = new float[pixels];
+  reference_convolution(image, expected, Nx, Ny, filter);
+
+  bool passed = true;
+  try {
+    // Use compile-time macros to select either:
+    //  - the FPGA emulator device (CPU emulation of the FPGA)
+    //  - the FPGA device (a real FPGA)
+    //  - the simulator device
+#if FPGA_SIMULATOR
+    auto selector = sycl::ext::intel::fpga_simulator_selector_v;
+#elif FPGA_HARDWARE
+    auto selector = sycl::ext::intel::fpga_selector_v;
+#else  // #if FPGA_EMULATOR
+    auto selector = sycl::ext::intel::fpga_emulator_selector_v;
+#endif
+
+    sycl::queue q(selector, sycl::property::queue::enable_profiling{});
+
+    auto device = q.get_device();
+    std::cout << "Running on device: "
+              << device.get_info<sycl::info::device::name>().c_str()
+              << std::endl;
+
+    float* in = static_cast<float*>(sycl::aligned_alloc_device(ALIGNMENT, pixels * sizeof(float), q));
+    float* out = static_cast<float*>(sycl::aligned_alloc_device(ALIGNMENT, pixels * sizeof(float), q));
+    q.memcpy(in, image, pixels * sizeof(float)).wait();
+
+    auto run = [&](const char* name, auto launch) {
+      q.memset(out, 0, pixels * sizeof(float)).wait();
+      sycl::event e = launch();
+      e.wait();
+      q.memcpy(result, out, pixels * sizeof(float)).wait();
+      double ms = kernel_time(e);
+      std::cout << std::setw(28) << name << ": " << std::fixed
+                << std::setprecision(3) << ms << " ms, "
+                << pixels / (ms * 1e3) << " Mpixels/s" << std::endl;
+      passed &= check(name, result, expected, Nx, Ny);
+    };
+
+    run("naive ND-range", [&]() {
+      return naive_convolution(q, in, out, Nx, Ny, filter);
+    });
+    run("line buffer", [&]() {
+      return line_buffer_convolution<false>(q, in, out, Nx, Ny, filter);
+    });
+    if (filter.separable) {
+      run("line buffer (separable)", [&]() {
+        return line_buffer_convolution<true>(q, in, out, Nx, Ny, filter);
+      });
+    }
+
+    std::cout << " Saving image  " << std::endl;
+    save_image("output.png", result, Nx, Ny);
+
+    // End to end comparison of the float and 8-bit paths: copy in, kernel
+    // and copy out, with the pixel type used for the transfers.
+    std::vector<uint8_t> image_u8(pixels), result_u8(pixels);
+    for (size_t i = 0; i < pixels; i++) image_u8[i] = static_cast<uint8_t>(image[i]);
+    uint8_t* in_u8 = sycl::malloc_device<uint8_t>(pixels, q);
+    uint8_t* out_u8 = sycl::malloc_device<uint8_t>(pixels, q);
+    FixedFilter fixed_filter = quantize(filter);
+
+    auto transfer_path = [&](const char* name, auto* host_in, auto* host_out,
+                             auto* dev_in, auto* dev_out, auto launch) {
+      size_t bytes = pixels * sizeof(*host_in);
+      sycl::event copy_in = q.memcpy(dev_in, host_in, bytes);
+      sycl::event kernel = launch(copy_in);
+      sycl::event copy_out = q.memcpy(host_out, dev_out, bytes, kernel);
+      copy_out.wait();
+      double start = copy_in.get_profiling_info<sycl::info::event_profiling::command_start>();
+      double end = copy_out.get_profiling_info<sycl::info::event_profiling::command_end>();
+      double ms = (end - start) * 1e-6;
+      std::cout << std::setw(28) << name << ": " << 2 * bytes
+                << " bytes moved, " << ms << " ms, "
+                << pixels / (ms * 1e3) << " Mpixels/s, "
+                << 2 * bytes / (ms * 1e6) << " GB/s" << std::endl;
+    };
+
+    transfer_path("float path", image, result, in, out, [&](sycl::event dep) {
+      return filter.separable
+                 ? line_buffer_convolution<true>(q, in, out, Nx, Ny, filter, {dep})
+                 : line_buffer_convolution<false>(q, in, out, Nx, Ny, filter, {dep});
+    });
+    transfer_path("uint8 fixed point path", image_u8.data(), result_u8.data(),
+                  in_u8, out_u8, [&](sycl::event dep) {
+      return filter.separable
+                 ? line_buffer_convolution_u8<true>(q, in_u8, out_u8, Nx, Ny, fixed_filter, {dep})
+                 : line_buffer_convolution_u8<false>(q, in_u8, out_u8, Nx, Ny, fixed_filter, {dep});
+    });
+
+    // the quantized taps may move a pixel by one level
+    for (size_t i = 0; i < pixels; i++) {
+      float v = std::nearbyint(expected[i]);
+      int ref = v < 0.0f ? 0 : (v > 255.0f ? 255 : int(v));
+      if (std::abs(int(result_u8[i]) - ref) > 1) {
+        std::cout << "uint8 path: pixel (" << i / Ny << "," << i % Ny
+                  << ") = " << int(result_u8[i]) << ", expected " << ref
+                  << std::endl;
+        passed = false;
+        break;
+      }
+    }
+
+    sycl::free(in, q);
+    sycl::free(out, q);
+    sycl::free(in_u8, q);
+    sycl::free(out_u8, q);
+  } catch (sycl::exception const &e) {
+    // Catches exceptions in the host code.
+    std::cerr << "Caught a SYCL host exception:\n" << e.what() << "\n";
+
+    // Most likely the runtime couldn't find FPGA hardware!
+    if (e.code().value() == CL_DEVICE_NOT_FOUND) {
+      std::cerr << "If you are targeting an FPGA, please ensure that your "
+                   "system has a correctly configured FPGA board.\n";
+      std::cerr << "Run sys_check in the oneAPI root directory to verify.\n";
+      std::cerr << "If you are targeting the FPGA emulator, compile with "
+                   "-DFPGA_EMULATOR.\n";
+    }
+    std::terminate();
+  }
+
+  std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+
+  delete[] image;
+  delete[] expected;
+  delete[] result;
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,144 @@
+#ifndef CONVOLUTION_U8_HPP
+#define CONVOLUTION_U8_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+#include "convolution.hpp"
+
+////////////////////////////////////////////////////////////////////////
+//
+// 8-bit path of the line buffer convolution.
+//
+// Images that started as 8-bit pixels are moved to the device as uint8
+// instead of float, which divides the transfer volume and the line
+// buffer memory by 4. The taps are quantized to fixed point with
+// kFracBits fractional bits, products are accumulated in integers on
+// chip and the result is rounded and saturated back to uint8, like
+// convertTo(CV_8U) does for the float path.
+//
+////////////////////////////////////////////////////////////////////////
+constexpr int kFracBits = 14;
+
+struct FixedFilter {
+  bool separable;
+  int32_t taps[kMaxKernelSize * kMaxKernelSize];
+  int32_t vert[kMaxKernelSize];
+  int32_t horiz[kMaxKernelSize];
+};
+
+inline FixedFilter quantize(const Filter& f) {
+  FixedFilter q{};
+  q.separable = f.separable;
+  auto fixed = [](float v) {
+    return static_cast<int32_t>(std::lround(v * (1 << kFracBits)));
+  };
+  for (int i = 0; i < kMaxKernelSize * kMaxKernelSize; i++) q.taps[i] = fixed(f.taps[i]);
+  for (int i = 0; i < kMaxKernelSize; i++) {
+    q.vert[i] = fixed(f.vert[i]);
+    q.horiz[i] = fixed(f.horiz[i]);
+  }
+  return q;
+}
+
+// Round a fixed point value with `frac` fractional bits and saturate it
+template <typename T>
+inline uint8_t saturate_u8(T value, int frac) {
+  T rounded = (value + (T(1) << (frac - 1))) >> frac;
+  return rounded < 0 ? 0 : (rounded > 255 ? 255 : static_cast<uint8_t>(rounded));
+}
+
+// Forward declare the kernel name in the global scope. This is an FPGA best
+// practice that reduces name mangling in the optimization reports.
+template <bool kSeparable> class LineBufferConvU8ID;
+
+template <bool kSeparable>
+sycl::event line_buffer_convolution_u8(sycl::queue& q, const uint8_t* in,
+                                       uint8_t* out, int rows, int cols,
+                                       const FixedFilter& filter,
+                                       const std::vector<sycl::event>& deps = {}) {
+  FixedFilter f = filter;
+  return q.submit([&](sycl::handler& h) {
+    h.depends_on(deps);
+    h.single_task<LineBufferConvU8ID<kSeparable>>([=]()
+                                                  [[intel::kernel_args_restrict]] {
+      constexpr int K = kMaxKernelSize;
+      uint8_t line_buffer[K - 1][kMaxCols];
+      uint8_t window[K][K];
+      // vertical sums carry kFracBits fractional bits
+      int32_t vsum[K];
+
+      for (int x = 0; x < kMaxCols; x++) {
+        #pragma unroll
+        for (int r = 0; r < K - 1; r++) line_buffer[r][x] = 0;
+      }
+      #pragma unroll
+      for (int r = 0; r < K; r++) {
+        vsum[r] = 0;
+        #pragma unroll
+        for (int c = 0; c < K; c++) window[r][c] = 0;
+      }
+
+      const int padded_cols = cols + kRadius;
+      const int total = (rows + kRadius) * padded_cols;
+      int y = 0;
+      int x = 0;
+      [[intel::initiation_interval(1)]]
+      for (int step = 0; step < total; step++) {
+        uint8_t pixel = (y < rows && x < cols) ? in[y * cols + x] : 0;
+
+        uint8_t column[K];
+        #pragma unroll
+        for (int r = 0; r < K - 1; r++) column[r] = line_buffer[r][x];
+        column[K - 1] = pixel;
+        #pragma unroll
+        for (int r = 0; r < K - 1; r++) line_buffer[r][x] = column[r + 1];
+
+        uint8_t result;
+        if constexpr (kSeparable) {
+          int32_t v = 0;
+          #pragma unroll
+          for (int r = 0; r < K; r++) v += f.vert[r] * column[r];
+          #pragma unroll
+          for (int c = 0; c < K - 1; c++) vsum[c] = vsum[c + 1];
+          vsum[K - 1] = v;
+          // both stages add kFracBits: 64-bit accumulator
+          int64_t sum = 0;
+          #pragma unroll
+          for (int c = 0; c < K; c++) sum += int64_t(f.horiz[c]) * vsum[c];
+          result = saturate_u8(sum, 2 * kFracBits);
+        } else {
+          #pragma unroll
+          for (int r = 0; r < K; r++) {
+            #pragma unroll
+            for (int c = 0; c < K - 1; c++) window[r][c] = window[r][c + 1];
+            window[r][K - 1] = column[r];
+          }
+          int32_t sum = 0;
+          #pragma unroll
+          for (int r = 0; r < K; r++) {
+            #pragma unroll
+            for (int c = 0; c < K; c++) sum += f.taps[r * K + c] * window[r][c];
+          }
+          result = saturate_u8(sum, kFracBits);
+        }
+
+        int oy = y - kRadius;
+        int ox = x - kRadius;
+        if (oy >= 0 && ox >= 0) out[oy * cols + ox] = result;
+
+        if (++x == padded_cols) {
+          x = 0;
+          y++;
+        }
+      }
+    });
+  });
+}
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef IMAGE_IO_HPP
+#define IMAGE_IO_HPP
+
+#include <cstring>
+#include <iostream>
+#include <opencv2/opencv.hpp>
+
+// Same helpers as exercices/E10-convolution: grayscale images are handled
+// as row-major float arrays of Nx rows and Ny cols.
+
+inline float* load_image(const char* im_path, int* Nx, int* Ny){
+       cv::Mat image = cv::imread(im_path, cv::IMREAD_GRAYSCALE);
+
+       if (image.empty()) {
+           std::cerr << "Failed to load image!" << std::endl;
+           return nullptr;
+       }
+
+       // Convert to float
+       cv::Mat imageFloat;
+       image.convertTo(imageFloat, CV_32F);
+
+       // Allocate and copy to float*
+       *Nx = imageFloat.rows;
+       *Ny = imageFloat.cols;
+       int size = imageFloat.rows * imageFloat.cols;
+       float* buffer = new float[size];
+       std::memcpy(buffer, imageFloat.ptr<float>(), size * sizeof(float));
+
+       return buffer;
+}
+
+inline void save_image(const char* im_path,float* buffer, const int Nx, const int Ny){
+
+        // Create a CV_32F Mat from the buffer (no copy, wraps memory)
+        cv::Mat floatImage(Nx, Ny, CV_32F, buffer);
+
+        // Convert to 8-bit grayscale for saving or displaying
+        cv::Mat grayImage;
+        floatImage.convertTo(grayImage, CV_8U);
+
+        // Save or display
+        cv::imwrite(im_path, grayImage);
+}
+
+// Synthetic test image used when no file is given on the command line
+inline float test_pixel(int i, int j){
+       return (((i / 16) + (j / 16)) % 2) ? 200.0f : float((i + j) % 64);
+}
+
+inline float* make_test_image(int Nx, int Ny){
+       float* buffer = new float[Nx * Ny];
+       for (int i = 0; i < Nx; i++)
+         for (int j = 0; j < Ny; j++)
+           buffer[i * Ny + j] = test_pixel(i, j);
+       return buffer;
+}
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef STRIP_IO_HPP
+#define STRIP_IO_HPP
+
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////
+//
+// Row-wise access to 8-bit binary PGM (P5) images.
+//
+// cv::imread can only decode a whole image, so images which do not fit
+// in memory are streamed through this raw format instead: rows are read
+// with a seek and written as they are produced. Convert them with e.g.
+// "convert input.tif -depth 8 input.pgm".
+//
+////////////////////////////////////////////////////////////////////////
+
+class PgmReader {
+ public:
+  bool open(const char* path) {
+    file_.open(path, std::ios::binary);
+    std::string magic;
+    int maxval = 0;
+    if (!(file_ >> magic) || magic != "P5") return false;
+    if (!next_int(cols_) || !next_int(rows_) || !next_int(maxval)) return false;
+    if (maxval > 255) return false;
+    // a single whitespace separates the header from the pixels
+    file_.get();
+    data_start_ = file_.tellg();
+    row_.resize(cols_);
+    return true;
+  }
+
+  int rows() const { return rows_; }
+  int cols() const { return cols_; }
+
+  // Read count rows starting at row first and convert them to float
+  void read_rows(int first, int count, float* dst) {
+    file_.seekg(data_start_ + std::streamoff(first) * cols_);
+    for (int r = 0; r < count; r++) {
+      file_.read(reinterpret_cast<char*>(row_.data()), cols_);
+      for (int c = 0; c < cols_; c++) dst[size_t(r) * cols_ + c] = row_[c];
+    }
+  }
+
+ private:
+  bool next_int(int& value) {
+    // skip whitespace and comments
+    while (file_ >> std::ws && file_.peek() == '#') {
+      std::string comment;
+      std::getline(file_, comment);
+    }
+    return static_cast<bool>(file_ >> value);
+  }
+
+  std::ifstream file_;
+  std::streampos data_start_;
+  int rows_ = 0;
+  int cols_ = 0;
+  std::vector<unsigned char> row_;
+};
+
+class PgmWriter {
+ public:
+  bool open(const char* path, int rows, int cols) {
+    file_.open(path, std::ios::binary);
+    file_ << "P5\n" << cols << " " << rows << "\n255\n";
+    row_.resize(cols);
+    cols_ = cols;
+    return static_cast<bool>(file_);
+  }
+
+  // Append count rows, saturated to [0,255] like convertTo(CV_8U)
+  void write_rows(const float* src, int count) {
+    for (int r = 0; r < count; r++) {
+      for (int c = 0; c < cols_; c++) {
+        float v = std::nearbyint(src[size_t(r) * cols_ + c]);
+        row_[c] = static_cast<unsigned char>(v < 0.0f ? 0.0f : (v > 255.0f ? 255.0f : v));
+      }
+      file_.write(reinterpret_cast<const char*>(row_.data()), cols_);
+    }
+  }
+
+  // Returns false when a write failed
+  bool close() {
+    file_.close();
+    return !file_.fail();
+  }
+
+ private:
+  std::ofstream file_;
+  int cols_ = 0;
+  std::vector<unsigned char> row_;
+};
+
+#endif
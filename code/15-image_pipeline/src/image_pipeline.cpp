@@ -0,0 +1,206 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+#include "image_pipeline.hpp"
+
+#define ALIGNMENT 64
+
+// Time in ms from the first start to the last end of the events
+double span_time(const std::vector<sycl::event>& events) {
+  double start = 0.0, end = 0.0;
+  for (size_t i = 0; i < events.size(); i++) {
+    double s = events[i].get_profiling_info<sycl::info::event_profiling::command_start>();
+    double e = events[i].get_profiling_info<sycl::info::event_profiling::command_end>();
+    start = (i == 0) ? s : std::min(start, s);
+    end = (i == 0) ? e : std::max(end, e);
+  }
+  return (end - start) * 1e-6;
+}
+
+bool check(const char* name, const float* result, const float* expected,
+           const unsigned* hist, int rows, int cols) {
+  for (int i = 0; i < rows * cols; i++) {
+    float tol = 1e-3f * std::max(1.0f, std::fabs(expected[i]));
+    if (std::fabs(result[i] - expected[i]) > tol) {
+      std::cout << name << ": pixel (" << i / cols << "," << i % cols
+                << ") = " << result[i] << ", expected " << expected[i]
+                << std::endl;
+      return false;
+    }
+  }
+  std::vector<unsigned> bins(kBins, 0);
+  for (int i = 0; i < rows * cols; i++) bins[bin_of(result[i])]++;
+  for (int b = 0; b < kBins; b++) {
+    if (hist[b] != bins[b]) {
+      std::cout << name << ": bin " << b << " = " << hist[b] << ", expected "
+                << bins[b] << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+void usage(const char* exe) {
+  std::cout << "Usage: \n" << exe
+            << " [--stages blur,laplacian,threshold] [--threshold T]"
+               " [--rows R] [--cols C]"
+               "\n\nFAILED\n";
+}
+
+int main(int argc, char* argv[]) {
+  std::string stage_list = "blur,laplacian,threshold";
+  float threshold = 4.0f;
+  int rows = 1024;
+  int cols = 1024;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--stages") && i + 1 < argc) {
+      stage_list = argv[++i];
+    } else if (!strcmp(argv[i], "--threshold") && i + 1 < argc) {
+      threshold = std::stof(argv[++i]);
+    } else if (!strcmp(argv[i], "--rows") && i + 1 < argc) {
+      rows = std::stoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--cols") && i + 1 < argc) {
+      cols = std::stoi(argv[++i]);
+    } else {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::vector<Stage> stages;
+  std::stringstream list(stage_list);
+  std::string name;
+  while (std::getline(list, name, ',')) {
+    Stage s;
+    if (!make_stage(name, threshold, s)) {
+      std::cerr << "Unknown stage " << name << std::endl;
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+    stages.push_back(s);
+  }
+  if (stages.empty() || stages.size() > kMaxStages) {
+    std::cerr << "Between 1 and " << kMaxStages << " stages" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (cols + 1 > kMaxCols || rows < 1 || cols < 1) {
+    std::cerr << "Images wider than " << kMaxCols - 1
+              << " columns do not fit in the line buffers" << std::endl;
+    return EXIT_FAILURE;
+  }
+  // unused slots of the pipeline pass the pixels through
+  Stage slots[kMaxStages];
+  for (int i = 0; i < kMaxStages; i++) make_stage("pass", 0.0f, slots[i]);
+  std::copy(stages.begin(), stages.end(), slots);
+
+  const size_t pixels = size_t(rows) * cols;
+  float* image = new (std::align_val_t{ ALIGNMENT }) float[pixels];
+  float* expected = new (std::align_val_t{ ALIGNMENT }) float[pixels];
+  float* result = new (std::align_val_t{ ALIGNMENT }) float[pixels];
+  for (int i = 0; i < rows; i++)
+    for (int j = 0; j < cols; j++)
+      image[i * cols + j] = (((i / 16) + (j / 16)) % 2) ? 200.0f : float((i + j) % 64);
+
+  std::vector<float> tmp(image, image + pixels);
+  for (const Stage& s : stages) {
+    reference_stage(tmp.data(), expected, rows, cols, s);
+    std::copy(expected, expected + pixels, tmp.begin());
+  }
+
+  std::cout << "Image " << rows << "x" << cols << ", stages " << stage_list
+            << std::endl;
+
+  bool passed = true;
+  try {
+    // Use compile-time macros to select either:
+    //  - the FPGA emulator device (CPU emulation of the FPGA)
+    //  - the FPGA device (a real FPGA)
+    //  - the simulator device
+#if FPGA_SIMULATOR
+    auto selector = sycl::ext::intel::fpga_simulator_selector_v;
+#elif FPGA_HARDWARE
+    auto selector = sycl::ext::intel::fpga_selector_v;
+#else  // #if FPGA_EMULATOR
+    auto selector = sycl::ext::intel::fpga_emulator_selector_v;
+#endif
+
+    sycl::queue q(selector, sycl::property::queue::enable_profiling{});
+
+    auto device = q.get_device();
+    std::cout << "Running on device: "
+              << device.get_info<sycl::info::device::name>().c_str()
+              << std::endl;
+
+    const size_t bytes = pixels * sizeof(float);
+    float* in = static_cast<float*>(sycl::aligned_alloc_device(ALIGNMENT, bytes, q));
+    float* out = static_cast<float*>(sycl::aligned_alloc_device(ALIGNMENT, bytes, q));
+    float* scratch = static_cast<float*>(sycl::aligned_alloc_device(ALIGNMENT, bytes, q));
+    unsigned* hist = sycl::malloc_device<unsigned>(kBins, q);
+    unsigned host_hist[kBins];
+    q.memcpy(in, image, bytes).wait();
+
+    auto run = [&](const char* name, size_t global_bytes, auto launch) {
+      q.memset(out, 0, bytes).wait();
+      std::vector<sycl::event> events = launch();
+      q.wait();
+      q.memcpy(result, out, bytes).wait();
+      q.memcpy(host_hist, hist, sizeof(host_hist)).wait();
+      double ms = span_time(events);
+      std::cout << std::setw(24) << name << ": " << std::fixed
+                << std::setprecision(3) << ms << " ms, "
+                << pixels / (ms * 1e3) << " Mpixels/s, " << global_bytes
+                << " bytes of global memory traffic" << std::endl;
+      passed &= check(name, result, expected, host_hist, rows, cols);
+    };
+
+    // read the input once, write the output once
+    run("pipes", 2 * bytes, [&]() {
+      return submit_pipeline(q, in, out, hist, rows, cols, slots);
+    });
+    // every stage reads and writes an image, the histogram reads one more
+    run("global memory", (2 * stages.size() + 1) * bytes, [&]() {
+      return submit_global(q, in, out, scratch, hist, rows, cols, stages);
+    });
+
+    int mode = std::max_element(host_hist, host_hist + kBins) - host_hist;
+    std::cout << "Histogram: " << std::count_if(host_hist, host_hist + kBins,
+                                                [](unsigned n) { return n > 0; })
+              << " non-empty bins, most frequent value " << mode << " ("
+              << host_hist[mode] << " pixels)" << std::endl;
+
+    sycl::free(in, q);
+    sycl::free(out, q);
+    sycl::free(scratch, q);
+    sycl::free(hist, q);
+  } catch (sycl::exception const &e) {
+    // Catches exceptions in the host code.
+    std::cerr << "Caught a SYCL host exception:\n" << e.what() << "\n";
+
+    // Most likely the runtime couldn't find FPGA hardware!
+    if (e.code().value() == CL_DEVICE_NOT_FOUND) {
+      std::cerr << "If you are targeting an FPGA, please ensure that your "
+                   "system has a correctly configured FPGA board.\n";
+      std::cerr << "Run sys_check in the oneAPI root directory to verify.\n";
+      std::cerr << "If you are targeting the FPGA emulator, compile with "
+                   "-DFPGA_EMULATOR.\n";
+    }
+    std::terminate();
+  }
+
+  delete[] image;
+  delete[] expected;
+  delete[] result;
+
+  std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
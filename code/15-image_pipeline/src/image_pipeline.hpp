@@ -0,0 +1,299 @@
+#ifndef IMAGE_PIPELINE_HPP
+#define IMAGE_PIPELINE_HPP
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+////////////////////////////////////////////////////////////////////////
+//
+// Image pipeline built from kernels connected by pipes.
+//
+//   reader -> slot 0 -> slot 1 -> ... -> slot N-1 -> writer -> histogram
+//
+// Every slot is a 3x3 streaming stage with line buffers. Its operation
+// (blur, laplacian, threshold or pass) is a runtime parameter, so the
+// host chooses the chain without recompiling the bitstream; unused slots
+// pass the pixels through. Only the reader and the writer access global
+// memory, the intermediate images stay in the pipes.
+//
+// The same stage code is also run as separate kernels reading and
+// writing global memory, which is what the pipeline is compared to.
+//
+////////////////////////////////////////////////////////////////////////
+
+// Slots instantiated in the bitstream
+constexpr int kMaxStages = 4;
+// Widest image row held in the on-chip line buffers (halo included)
+constexpr int kMaxCols = 8192;
+// Pixels buffered between two kernels
+constexpr int kPipeDepth = 64;
+constexpr int kBins = 256;
+// Recent histogram updates forwarded from registers, at least the latency
+// of the read-modify-write of a bin
+constexpr int kHistCacheDepth = 8;
+
+enum StageOp { kPass = 0, kStencil = 1, kThreshold = 2 };
+
+struct Stage {
+  int op;
+  // 3x3 taps of a stencil, applied as a correlation with zero padding
+  float taps[9];
+  // threshold: 255 above, 0 otherwise
+  float threshold;
+};
+
+// blur (3x3 binomial), laplacian (4-neighbour stencil of E10), threshold
+inline bool make_stage(const std::string& name, float threshold, Stage& s) {
+  s = Stage{};
+  if (name == "blur") {
+    const float w[3] = {1.0f, 2.0f, 1.0f};
+    s.op = kStencil;
+    for (int r = 0; r < 3; r++)
+      for (int c = 0; c < 3; c++) s.taps[r * 3 + c] = w[r] * w[c] / 16.0f;
+  } else if (name == "laplacian") {
+    s.op = kStencil;
+    for (int i = 0; i < 9; i++) s.taps[i] = (i % 2) ? 1.0f : 0.0f;
+    s.taps[4] = -4.0f;
+  } else if (name == "threshold") {
+    s.op = kThreshold;
+    s.threshold = threshold;
+  } else if (name == "pass") {
+    s.op = kPass;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// Forward declare the kernel names in the global scope. This is an FPGA best
+// practice that reduces name mangling in the optimization reports.
+class ReaderID;
+template <int kSlot> class SlotID;
+class WriterID;
+class HistogramID;
+class GlobalStageID;
+class GlobalHistogramID;
+
+template <int kIndex> class ImagePipeID;
+template <int kIndex>
+using ImagePipe = sycl::ext::intel::pipe<ImagePipeID<kIndex>, float, kPipeDepth>;
+using HistogramPipe = sycl::ext::intel::pipe<class HistogramPipeID, float, kPipeDepth>;
+
+inline float apply_stage(const Stage& s, const float (&window)[3][3]) {
+  float sum = 0.0f;
+  #pragma unroll
+  for (int r = 0; r < 3; r++) {
+    #pragma unroll
+    for (int c = 0; c < 3; c++) sum += s.taps[r * 3 + c] * window[r][c];
+  }
+  float center = window[1][1];
+  if (s.op == kStencil) return sum;
+  if (s.op == kThreshold) return center > s.threshold ? 255.0f : 0.0f;
+  return center;
+}
+
+// Pixel value to histogram bin, saturated like convertTo(CV_8U)
+inline int bin_of(float v) {
+  int b = static_cast<int>(v + 0.5f);
+  return b < 0 ? 0 : (b > kBins - 1 ? kBins - 1 : b);
+}
+
+////////////////////////////////////////////////////////////////////////
+//
+// One stage over a rows x cols image. The walk is padded by one row and
+// one column: output pixel (y-1, x-1) is the centre of the window once
+// pixel (y, x) has been read. read(i) and write(i, v) are the pixel
+// source and sink, pipes or global memory; both see the pixels in
+// raster order.
+//
+////////////////////////////////////////////////////////////////////////
+template <typename Read, typename Write>
+void stream_stage(int rows, int cols, const Stage& s, Read read, Write write) {
+  // line_buffer[r][x] holds pixel (y - 2 + r, x)
+  float line_buffer[2][kMaxCols];
+  float window[3][3];
+
+  for (int x = 0; x < kMaxCols; x++) {
+    line_buffer[0][x] = 0.0f;
+    line_buffer[1][x] = 0.0f;
+  }
+  #pragma unroll
+  for (int r = 0; r < 3; r++) {
+    #pragma unroll
+    for (int c = 0; c < 3; c++) window[r][c] = 0.0f;
+  }
+
+  const int padded_cols = cols + 1;
+  const int total = (rows + 1) * padded_cols;
+  int y = 0;
+  int x = 0;
+  [[intel::initiation_interval(1)]]
+  for (int step = 0; step < total; step++) {
+    float pixel = (y < rows && x < cols) ? read(y * cols + x) : 0.0f;
+
+    float column[3] = {line_buffer[0][x], line_buffer[1][x], pixel};
+    line_buffer[0][x] = column[1];
+    line_buffer[1][x] = column[2];
+    #pragma unroll
+    for (int r = 0; r < 3; r++) {
+      window[r][0] = window[r][1];
+      window[r][1] = window[r][2];
+      window[r][2] = column[r];
+    }
+
+    int oy = y - 1;
+    int ox = x - 1;
+    if (oy >= 0 && ox >= 0) write(oy * cols + ox, apply_stage(s, window));
+
+    if (++x == padded_cols) {
+      x = 0;
+      y++;
+    }
+  }
+}
+
+// The increment of a data-dependent bin is a read-modify-write carried
+// across iterations, which would keep the loop (and the pipes feeding it)
+// above II=1. The last kHistCacheDepth updates are kept in a shift
+// register: a bin updated less than kHistCacheDepth iterations ago takes
+// its count from there, so the on-chip bins array only sees dependencies
+// at distance kHistCacheDepth or more, which ivdep tells the compiler.
+template <typename Read>
+void stream_histogram(int pixels, Read read, unsigned* hist) {
+  unsigned bins[kBins];
+  for (int b = 0; b < kBins; b++) bins[b] = 0;
+
+  int recent_bin[kHistCacheDepth];
+  unsigned recent_count[kHistCacheDepth];
+#pragma unroll
+  for (int j = 0; j < kHistCacheDepth; j++) {
+    recent_bin[j] = -1;
+    recent_count[j] = 0;
+  }
+
+  [[intel::ivdep(bins, kHistCacheDepth)]]
+  for (int i = 0; i < pixels; i++) {
+    int b = bin_of(read(i));
+    unsigned count = bins[b];
+    // oldest first, so that the most recent update of b wins
+#pragma unroll
+    for (int j = 0; j < kHistCacheDepth; j++)
+      if (recent_bin[j] == b) count = recent_count[j];
+    count++;
+    bins[b] = count;
+#pragma unroll
+    for (int j = 0; j < kHistCacheDepth - 1; j++) {
+      recent_bin[j] = recent_bin[j + 1];
+      recent_count[j] = recent_count[j + 1];
+    }
+    recent_bin[kHistCacheDepth - 1] = b;
+    recent_count[kHistCacheDepth - 1] = count;
+  }
+  for (int b = 0; b < kBins; b++) hist[b] = bins[b];
+}
+
+////////////////////////////////////////////////////////////////////////
+//
+// Pipe-connected version. All the kernels are submitted at once and run
+// concurrently; the returned events cover every kernel of the pipeline.
+//
+////////////////////////////////////////////////////////////////////////
+template <int kSlot>
+void submit_slots(sycl::queue& q, int rows, int cols, const Stage* stages,
+                  std::vector<sycl::event>& events) {
+  if constexpr (kSlot < kMaxStages) {
+    Stage s = stages[kSlot];
+    events.push_back(q.single_task<SlotID<kSlot>>([=]() {
+      stream_stage(
+          rows, cols, s, [](int) { return ImagePipe<kSlot>::read(); },
+          [](int, float v) { ImagePipe<kSlot + 1>::write(v); });
+    }));
+    submit_slots<kSlot + 1>(q, rows, cols, stages, events);
+  }
+}
+
+// stages holds kMaxStages entries, padded with kPass
+inline std::vector<sycl::event> submit_pipeline(sycl::queue& q, const float* in,
+                                                float* out, unsigned* hist,
+                                                int rows, int cols,
+                                                const Stage* stages) {
+  const int pixels = rows * cols;
+  std::vector<sycl::event> events;
+
+  events.push_back(q.single_task<ReaderID>([=]() [[intel::kernel_args_restrict]] {
+    for (int i = 0; i < pixels; i++) ImagePipe<0>::write(in[i]);
+  }));
+  submit_slots<0>(q, rows, cols, stages, events);
+  events.push_back(q.single_task<WriterID>([=]() [[intel::kernel_args_restrict]] {
+    for (int i = 0; i < pixels; i++) {
+      float v = ImagePipe<kMaxStages>::read();
+      out[i] = v;
+      HistogramPipe::write(v);
+    }
+  }));
+  events.push_back(q.single_task<HistogramID>([=]() {
+    stream_histogram(pixels, [](int) { return HistogramPipe::read(); }, hist);
+  }));
+  return events;
+}
+
+////////////////////////////////////////////////////////////////////////
+//
+// Global memory version: one kernel per configured stage, the
+// intermediate images ping-pong between two device buffers.
+//
+////////////////////////////////////////////////////////////////////////
+inline std::vector<sycl::event> submit_global(sycl::queue& q, const float* in,
+                                              float* out, float* tmp,
+                                              unsigned* hist, int rows, int cols,
+                                              const std::vector<Stage>& stages) {
+  const int pixels = rows * cols;
+  std::vector<sycl::event> events;
+  const float* src = in;
+  for (size_t i = 0; i < stages.size(); i++) {
+    // the last stage writes to out, the others alternate between tmp and out
+    float* dst = ((stages.size() - 1 - i) % 2) ? tmp : out;
+    Stage s = stages[i];
+    events.push_back(q.submit([&](sycl::handler& h) {
+      if (!events.empty()) h.depends_on(events.back());
+      h.single_task<GlobalStageID>([=]() [[intel::kernel_args_restrict]] {
+        stream_stage(
+            rows, cols, s, [=](int j) { return src[j]; },
+            [=](int j, float v) { dst[j] = v; });
+      });
+    }));
+    src = dst;
+  }
+  events.push_back(q.submit([&](sycl::handler& h) {
+    if (!events.empty()) h.depends_on(events.back());
+    h.single_task<GlobalHistogramID>([=]() {
+      stream_histogram(pixels, [=](int j) { return src[j]; }, hist);
+    });
+  }));
+  return events;
+}
+
+// Host reference of one stage
+inline void reference_stage(const float* in, float* out, int rows, int cols,
+                            const Stage& s) {
+  for (int y = 0; y < rows; y++)
+    for (int x = 0; x < cols; x++) {
+      float window[3][3];
+      for (int r = 0; r < 3; r++)
+        for (int c = 0; c < 3; c++) {
+          int iy = y - 1 + r;
+          int ix = x - 1 + c;
+          window[r][c] = (iy >= 0 && iy < rows && ix >= 0 && ix < cols)
+                             ? in[iy * cols + ix]
+                             : 0.0f;
+        }
+      out[y * cols + x] = apply_stage(s, window);
+    }
+}
+
+#endif
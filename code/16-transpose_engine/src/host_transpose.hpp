@@ -0,0 +1,59 @@
+#ifndef HOST_TRANSPOSE_HPP
+#define HOST_TRANSPOSE_HPP
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////
+//
+// Host transpose, used as the reference of the device kernels and as the
+// back end when no device is available.
+//
+// The matrix is split recursively along its longer side until a block
+// fits in kLeaf x kLeaf: at every level the working set of a block is
+// half the previous one, so some level fits in each cache without
+// knowing its size (cache-oblivious). In a leaf the inner loop writes a
+// contiguous row of out, which the compiler vectorizes, and the strided
+// reads stay in the few cache lines of the leaf. The rows are split in
+// bands between the threads.
+//
+////////////////////////////////////////////////////////////////////////
+constexpr int kLeaf = 32;
+
+template <typename T>
+void transpose_block(const T* in, T* out, int rows, int cols, int r0, int r1,
+                     int c0, int c1) {
+  if (r1 - r0 <= kLeaf && c1 - c0 <= kLeaf) {
+    for (int c = c0; c < c1; c++) {
+      T* dst = out + size_t(c) * rows;
+      for (int r = r0; r < r1; r++) dst[r] = in[size_t(r) * cols + c];
+    }
+  } else if (r1 - r0 >= c1 - c0) {
+    int rm = r0 + (r1 - r0) / 2;
+    transpose_block(in, out, rows, cols, r0, rm, c0, c1);
+    transpose_block(in, out, rows, cols, rm, r1, c0, c1);
+  } else {
+    int cm = c0 + (c1 - c0) / 2;
+    transpose_block(in, out, rows, cols, r0, r1, c0, cm);
+    transpose_block(in, out, rows, cols, r0, r1, cm, c1);
+  }
+}
+
+// out (cols x rows) = in (rows x cols)^T with threads threads (0: all cores)
+template <typename T>
+void host_transpose(const T* in, T* out, int rows, int cols, int threads = 0) {
+  if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+  // bands are whole leaves so that no two threads share a leaf
+  int leaves = (rows + kLeaf - 1) / kLeaf;
+  threads = std::min(threads, leaves);
+  std::vector<std::thread> pool;
+  for (int t = 0; t < threads; t++) {
+    int r0 = std::min(rows, leaves * t / threads * kLeaf);
+    int r1 = std::min(rows, leaves * (t + 1) / threads * kLeaf);
+    pool.emplace_back([=]() { transpose_block(in, out, rows, cols, r0, r1, 0, cols); });
+  }
+  for (auto& t : pool) t.join();
+}
+
+#endif
@@ -0,0 +1,231 @@
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+#include "host_transpose.hpp"
+#include "transpose.hpp"
+
+#define ALIGNMENT 64
+
+// Kernel time in ms from the profiling information of the event
+double kernel_time(const sycl::event& e) {
+  double start = e.get_profiling_info<sycl::info::event_profiling::command_start>();
+  double end = e.get_profiling_info<sycl::info::event_profiling::command_end>();
+  return (end - start) * 1e-6;
+}
+
+void usage(const char* exe) {
+  std::cout << "Usage: \n" << exe
+            << " [--rows R] [--cols C] [--type float|double|int] [--threads T]"
+               " [--host]"
+               "\n\nFAILED\n";
+}
+
+// Compare with the host transpose, both laid out as cols x rows
+template <typename T>
+bool check(const char* name, const T* result, const T* expected, int rows, int cols) {
+  const size_t elements = size_t(rows) * cols;
+  auto mismatch = std::mismatch(result, result + elements, expected);
+  if (mismatch.first == result + elements) return true;
+  size_t i = mismatch.first - result;
+  std::cout << name << ": element (" << i / rows << "," << i % rows << ") = "
+            << *mismatch.first << ", expected " << *mismatch.second << std::endl;
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////
+//
+// Benchmark of one element type. Every version reads and writes the
+// whole matrix once, the bandwidth is 2 * bytes / time, and the device
+// to device memcpy gives the bandwidth that a transpose can hope for.
+// The host transpose runs first and is the reference of the others;
+// without a queue it is the only back end.
+//
+////////////////////////////////////////////////////////////////////////
+template <typename T>
+bool benchmark(sycl::queue* device_queue, int rows, int cols, int threads) {
+  const size_t elements = size_t(rows) * cols;
+  const size_t bytes = elements * sizeof(T);
+  T* mat = new (std::align_val_t{ ALIGNMENT }) T[elements];
+  T* expected = new (std::align_val_t{ ALIGNMENT }) T[elements];
+  T* result = new (std::align_val_t{ ALIGNMENT }) T[elements];
+  for (size_t i = 0; i < elements; i++) mat[i] = static_cast<T>(i % 100003);
+
+  auto report = [&](const char* name, double ms) {
+    std::cout << std::setw(28) << name << ": " << std::fixed
+              << std::setprecision(3) << ms << " ms, "
+              << 2 * bytes / (ms * 1e6) << " GB/s" << std::endl;
+  };
+
+  // first touch of expected outside of the timing
+  std::fill(expected, expected + elements, T(0));
+  auto start = std::chrono::steady_clock::now();
+  host_transpose(mat, expected, rows, cols, threads);
+  report("host (cache-oblivious)",
+         std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+  bool passed = true;
+  if (device_queue == nullptr) {
+    // only a sanity check of the host back end: a few elements
+    for (int y = 0; y < rows; y += std::max(1, rows / 7))
+      for (int x = 0; x < cols; x += std::max(1, cols / 7))
+        passed &= expected[size_t(x) * rows + y] == mat[size_t(y) * cols + x];
+    delete[] mat;
+    delete[] expected;
+    delete[] result;
+    return passed;
+  }
+  sycl::queue& q = *device_queue;
+
+  T* in = static_cast<T*>(sycl::aligned_alloc_device(ALIGNMENT, bytes, q));
+  T* out = static_cast<T*>(sycl::aligned_alloc_device(ALIGNMENT, bytes, q));
+  q.memcpy(in, mat, bytes).wait();
+  auto run = [&](const char* name, auto launch) {
+    q.memset(out, 0, bytes).wait();
+    sycl::event e = launch();
+    e.wait();
+    q.memcpy(result, out, bytes).wait();
+    report(name, kernel_time(e));
+    passed &= check(name, result, expected, rows, cols);
+  };
+
+  sycl::event copy = q.memcpy(out, in, bytes);
+  copy.wait();
+  report("memcpy (baseline)", kernel_time(copy));
+
+  run("naive", [&]() { return naive_transpose(q, in, out, rows, cols); });
+  run("tiled (local memory)", [&]() { return tiled_transpose(q, in, out, rows, cols); });
+
+  if (rows == cols) {
+    q.memcpy(out, in, bytes).wait();
+    sycl::event e = in_place_transpose(q, out, rows);
+    e.wait();
+    q.memcpy(result, out, bytes).wait();
+    report("in-place (tile swap)", kernel_time(e));
+    passed &= check("in-place", result, expected, rows, cols);
+  } else {
+    // A rectangular matrix changes shape in place: the elements follow
+    // permutation cycles that do not map to tiles. The result goes
+    // through a scratch buffer and is copied back to the same allocation.
+    q.memcpy(out, in, bytes).wait();
+    T* scratch = static_cast<T*>(sycl::aligned_alloc_device(ALIGNMENT, bytes, q));
+    sycl::event t = tiled_transpose(q, out, scratch, rows, cols);
+    sycl::event c = q.memcpy(out, scratch, bytes, t);
+    c.wait();
+    double ms = (c.get_profiling_info<sycl::info::event_profiling::command_end>() -
+                 t.get_profiling_info<sycl::info::event_profiling::command_start>()) * 1e-6;
+    q.memcpy(result, out, bytes).wait();
+    report("in-place (via scratch)", ms);
+    passed &= check("in-place", result, expected, rows, cols);
+    sycl::free(scratch, q);
+  }
+
+  sycl::free(in, q);
+  sycl::free(out, q);
+  delete[] mat;
+  delete[] expected;
+  delete[] result;
+  return passed;
+}
+
+bool benchmark(const std::string& type, sycl::queue* q, int rows, int cols,
+               int threads) {
+  if (type == "float") return benchmark<float>(q, rows, cols, threads);
+  if (type == "double") return benchmark<double>(q, rows, cols, threads);
+  return benchmark<int>(q, rows, cols, threads);
+}
+
+int main(int argc, char* argv[]) {
+  int rows = 2048;
+  int cols = 1024;
+  std::string type = "float";
+  int threads = 0;
+  bool host_only = false;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--rows") && i + 1 < argc) {
+      rows = std::stoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--cols") && i + 1 < argc) {
+      cols = std::stoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--type") && i + 1 < argc) {
+      type = argv[++i];
+    } else if (!strcmp(argv[i], "--threads") && i + 1 < argc) {
+      threads = std::stoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--host")) {
+      host_only = true;
+    } else {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (rows < 1 || cols < 1 || (type != "float" && type != "double" && type != "int")) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Transpose of a " << rows << "x" << cols << " " << type
+            << " matrix" << std::endl;
+
+  bool passed = true;
+  if (host_only) {
+    passed = benchmark(type, nullptr, rows, cols, threads);
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+  // Only a missing FPGA falls back to the host transpose: any other
+  // failure, and every failure of the device benchmark, terminates.
+  std::optional<sycl::queue> q;
+  try {
+    // Use compile-time macros to select either:
+    //  - the FPGA emulator device (CPU emulation of the FPGA)
+    //  - the FPGA device (a real FPGA)
+    //  - the simulator device
+#if FPGA_SIMULATOR
+    auto selector = sycl::ext::intel::fpga_simulator_selector_v;
+#elif FPGA_HARDWARE
+    auto selector = sycl::ext::intel::fpga_selector_v;
+#else  // #if FPGA_EMULATOR
+    auto selector = sycl::ext::intel::fpga_emulator_selector_v;
+#endif
+
+    q.emplace(selector, sycl::property::queue::enable_profiling{});
+  } catch (sycl::exception const &e) {
+    if (e.code().value() != CL_DEVICE_NOT_FOUND) {
+      std::cerr << "Caught a SYCL host exception:\n" << e.what() << "\n";
+      std::terminate();
+    }
+    std::cerr << "No FPGA device found:\n" << e.what() << "\n";
+    std::cerr << "If you are targeting an FPGA, please ensure that your "
+                 "system has a correctly configured FPGA board.\n";
+    std::cerr << "Run sys_check in the oneAPI root directory to verify.\n";
+    std::cerr << "If you are targeting the FPGA emulator, compile with "
+                 "-DFPGA_EMULATOR.\n";
+    std::cerr << "Falling back to the host transpose\n";
+    passed = benchmark(type, nullptr, rows, cols, threads);
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  try {
+    auto device = q->get_device();
+    std::cout << "Running on device: "
+              << device.get_info<sycl::info::device::name>().c_str()
+              << std::endl;
+
+    passed = benchmark(type, &*q, rows, cols, threads);
+  } catch (sycl::exception const &e) {
+    // Catches exceptions in the host code.
+    std::cerr << "Caught a SYCL host exception:\n" << e.what() << "\n";
+    std::terminate();
+  }
+
+  std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,176 @@
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+#include "blas1.hpp"
+
+#define ALIGNMENT 64
+
+// Kernel time in ms from the profiling information of the event
+double kernel_time(const sycl::event& e) {
+  double start = e.get_profiling_info<sycl::info::event_profiling::command_start>();
+  double end = e.get_profiling_info<sycl::info::event_profiling::command_end>();
+  return (end - start) * 1e-6;
+}
+
+bool check(const char* name, double result, double expected) {
+  if (std::fabs(result - expected) > 1e-12 * std::max(1.0, std::fabs(expected))) {
+    std::cout << name << ": result " << result << ", expected " << expected
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+void usage(const char* exe) {
+  std::cout << "Usage: \n" << exe << " [--size N]\n\nFAILED\n";
+}
+
+int main(int argc, char* argv[]) {
+  int n = 1 << 24;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--size") && i + 1 < argc) {
+      n = std::stoi(argv[++i]);
+    } else {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (n < 1) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  bool passed = true;
+  try {
+    // Use compile-time macros to select either:
+    //  - the FPGA emulator device (CPU emulation of the FPGA)
+    //  - the FPGA device (a real FPGA)
+    //  - the simulator device
+#if FPGA_SIMULATOR
+    auto selector = sycl::ext::intel::fpga_simulator_selector_v;
+#elif FPGA_HARDWARE
+    auto selector = sycl::ext::intel::fpga_selector_v;
+#else  // #if FPGA_EMULATOR
+    auto selector = sycl::ext::intel::fpga_emulator_selector_v;
+#endif
+
+    sycl::queue q(selector, sycl::property::queue::enable_profiling{});
+
+    auto device = q.get_device();
+    std::cout << "Running on device: "
+              << device.get_info<sycl::info::device::name>().c_str()
+              << std::endl;
+
+    // multiples of 1/4: every product and partial sum is exact, the
+    // result does not depend on the order of the additions
+    double* host_x = new (std::align_val_t{ ALIGNMENT }) double[n];
+    double* host_y = new (std::align_val_t{ ALIGNMENT }) double[n];
+    double* host_axpy = new (std::align_val_t{ ALIGNMENT }) double[n];
+    for (int i = 0; i < n; i++) {
+      host_x[i] = (i % 7) * 0.5;
+      host_y[i] = (i % 5) * 0.25;
+    }
+    const double alpha = 2.5;
+    double expected_dot = 0.0, expected_sq = 0.0;
+    for (int i = 0; i < n; i++) {
+      expected_dot += host_x[i] * host_y[i];
+      expected_sq += host_x[i] * host_x[i];
+    }
+
+    const size_t bytes = size_t(n) * sizeof(double);
+    double* x = static_cast<double*>(sycl::aligned_alloc_device(ALIGNMENT, bytes, q));
+    double* y = static_cast<double*>(sycl::aligned_alloc_device(ALIGNMENT, bytes, q));
+    double* result = sycl::malloc_device<double>(kGroups * kWorkGroupSize, q);
+    q.memcpy(x, host_x, bytes).wait();
+    q.memcpy(y, host_y, bytes).wait();
+
+    // the device to device copy is the reference bandwidth
+    sycl::event copy = q.memcpy(y, x, bytes);
+    copy.wait();
+    double peak = 2.0 * bytes / (kernel_time(copy) * 1e6);
+    q.memcpy(y, host_y, bytes).wait();
+    std::cout << std::setw(16) << "memcpy" << ": " << std::fixed
+              << std::setprecision(3) << peak << " GB/s" << std::endl;
+
+    // flops and bytes moved per element
+    auto report = [&](const char* name, const sycl::event& e, int flops, int moved) {
+      double ms = kernel_time(e);
+      double gbs = double(moved) * n / (ms * 1e6);
+      std::cout << std::setw(16) << name << ": " << ms << " ms, "
+                << double(flops) * n / (ms * 1e6) << " GFLOP/s, " << gbs
+                << " GB/s (" << 100.0 * gbs / peak << "% of memcpy)"
+                << std::endl;
+    };
+
+    double value = 0.0;
+    sycl::event e = naive_dot(q, x, y, result, n);
+    e.wait();
+    q.memcpy(&value, result, sizeof(double)).wait();
+    report("naive dot", e, 2, 16);
+    passed &= check("naive dot", value, expected_dot);
+
+    e = dot(q, x, y, result, n);
+    e.wait();
+    q.memcpy(&value, result, sizeof(double)).wait();
+    report("dot", e, 2, 16);
+    passed &= check("dot", value, expected_dot);
+
+    e = ndrange_dot(q, x, y, result, n);
+    e.wait();
+    std::vector<double> partial(kGroups * kWorkGroupSize);
+    q.memcpy(partial.data(), result, partial.size() * sizeof(double)).wait();
+    value = 0.0;
+    for (double p : partial) value += p;
+    report("ND-range dot", e, 2, 16);
+    passed &= check("ND-range dot", value, expected_dot);
+
+    e = nrm2(q, x, result, n);
+    e.wait();
+    q.memcpy(&value, result, sizeof(double)).wait();
+    report("nrm2", e, 2, 8);
+    passed &= check("nrm2", value, std::sqrt(expected_sq));
+
+    e = axpy(q, alpha, x, y, n);
+    e.wait();
+    q.memcpy(host_axpy, y, bytes).wait();
+    report("axpy", e, 2, 24);
+    for (int i = 0; i < n; i++) {
+      if (host_axpy[i] != alpha * host_x[i] + host_y[i]) {
+        check("axpy", host_axpy[i], alpha * host_x[i] + host_y[i]);
+        passed = false;
+        break;
+      }
+    }
+
+    sycl::free(x, q);
+    sycl::free(y, q);
+    sycl::free(result, q);
+    delete[] host_x;
+    delete[] host_y;
+    delete[] host_axpy;
+  } catch (sycl::exception const &e) {
+    // Catches exceptions in the host code.
+    std::cerr << "Caught a SYCL host exception:\n" << e.what() << "\n";
+
+    // Most likely the runtime couldn't find FPGA hardware!
+    if (e.code().value() == CL_DEVICE_NOT_FOUND) {
+      std::cerr << "If you are targeting an FPGA, please ensure that your "
+                   "system has a correctly configured FPGA board.\n";
+      std::cerr << "Run sys_check in the oneAPI root directory to verify.\n";
+      std::cerr << "If you are targeting the FPGA emulator, compile with "
+                   "-DFPGA_EMULATOR.\n";
+    }
+    std::terminate();
+  }
+
+  std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
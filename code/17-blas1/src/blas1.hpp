@@ -0,0 +1,139 @@
+#ifndef BLAS1_HPP
+#define BLAS1_HPP
+
+#include <cmath>
+#include <vector>
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+////////////////////////////////////////////////////////////////////////
+//
+// BLAS-1 kernels on doubles with a runtime length n.
+//
+// The single_task versions read kVec consecutive doubles per iteration
+// (the unrolled loads are coalesced into one wide load) and reduce them
+// with an unrolled adder tree. A double addition takes several cycles,
+// so accumulating the block sums in a single variable would give II > 1.
+// The block sums go instead into a shift register of kLatency + 1
+// partial sums, as in 06-shift_register: each partial sum is only
+// updated every kLatency iterations, which gives II = 1.
+//
+////////////////////////////////////////////////////////////////////////
+constexpr int kVec = 8;
+// Latency of the double adder, a bit more than the reports show
+constexpr int kLatency = 12;
+// ND-range version
+constexpr int kWorkGroupSize = 64;
+constexpr int kSimd = 4;
+constexpr int kGroups = 64;
+
+// Forward declare the kernel names in the global scope. This is an FPGA best
+// practice that reduces name mangling in the optimization reports.
+class NaiveDotID;
+class DotID;
+class AxpyID;
+class Nrm2ID;
+class NdRangeDotID;
+
+// Sum of squares (kSquare) or of products, II = 1
+template <bool kSquare>
+double shift_register_sum(const double* x, const double* y, int n) {
+  double shift_reg[kLatency + 1];
+  #pragma unroll
+  for (int i = 0; i < kLatency + 1; i++) shift_reg[i] = 0.0;
+
+  const int blocks = (n + kVec - 1) / kVec;
+  [[intel::initiation_interval(1)]]
+  for (int b = 0; b < blocks; b++) {
+    double prod[kVec];
+    #pragma unroll
+    for (int v = 0; v < kVec; v++) {
+      int i = b * kVec + v;
+      double xi = (i < n) ? x[i] : 0.0;
+      double yi = kSquare ? xi : ((i < n) ? y[i] : 0.0);
+      prod[v] = xi * yi;
+    }
+    // adder tree over the block
+    #pragma unroll
+    for (int step = 1; step < kVec; step *= 2) {
+      #pragma unroll
+      for (int v = 0; v < kVec; v += 2 * step) prod[v] += prod[v + step];
+    }
+
+    shift_reg[kLatency] = shift_reg[0] + prod[0];
+    #pragma unroll
+    for (int i = 0; i < kLatency; i++) shift_reg[i] = shift_reg[i + 1];
+  }
+
+  double sum = 0.0;
+  #pragma unroll
+  for (int i = 0; i < kLatency; i++) sum += shift_reg[i];
+  return sum;
+}
+
+// Plain loop: the loop-carried double addition limits the II
+inline sycl::event naive_dot(sycl::queue& q, const double* x, const double* y,
+                             double* result, int n) {
+  return q.single_task<NaiveDotID>([=]() [[intel::kernel_args_restrict]] {
+    double sum = 0.0;
+    for (int i = 0; i < n; i++) sum += x[i] * y[i];
+    *result = sum;
+  });
+}
+
+inline sycl::event dot(sycl::queue& q, const double* x, const double* y,
+                       double* result, int n) {
+  return q.single_task<DotID>([=]() [[intel::kernel_args_restrict]] {
+    *result = shift_register_sum<false>(x, y, n);
+  });
+}
+
+inline sycl::event nrm2(sycl::queue& q, const double* x, double* result, int n) {
+  return q.single_task<Nrm2ID>([=]() [[intel::kernel_args_restrict]] {
+    // no rescaling: the sum of squares must not overflow
+    *result = sycl::sqrt(shift_register_sum<true>(x, x, n));
+  });
+}
+
+// y = alpha * x + y, no reduction: kVec elements per cycle
+inline sycl::event axpy(sycl::queue& q, double alpha, const double* x,
+                        double* y, int n) {
+  return q.single_task<AxpyID>([=]() [[intel::kernel_args_restrict]] {
+    const int blocks = (n + kVec - 1) / kVec;
+    [[intel::initiation_interval(1)]]
+    for (int b = 0; b < blocks; b++) {
+      #pragma unroll
+      for (int v = 0; v < kVec; v++) {
+        int i = b * kVec + v;
+        if (i < n) y[i] = alpha * x[i] + y[i];
+      }
+    }
+  });
+}
+
+////////////////////////////////////////////////////////////////////////
+//
+// ND-range dot product: kGroups work-groups of kWorkGroupSize work-items
+// vectorized kSimd times. Each work-item accumulates a strided part of
+// the vectors, so that consecutive work-items read consecutive doubles,
+// and writes its partial sum; the few partial sums are added on the host.
+//
+////////////////////////////////////////////////////////////////////////
+inline sycl::event ndrange_dot(sycl::queue& q, const double* x, const double* y,
+                               double* partial, int n) {
+  return q.parallel_for<NdRangeDotID>(
+      sycl::nd_range<1>(sycl::range<1>(kGroups * kWorkGroupSize),
+                        sycl::range<1>(kWorkGroupSize)),
+      [=](sycl::nd_item<1> it)
+      [[intel::kernel_args_restrict, intel::num_simd_work_items(kSimd),
+        sycl::reqd_work_group_size(1, 1, kWorkGroupSize)]] {
+        int gid = it.get_global_id(0);
+        double sum = 0.0;
+        for (int i = gid; i < n; i += kGroups * kWorkGroupSize) sum += x[i] * y[i];
+        partial[gid] = sum;
+      });
+}
+
+#endif
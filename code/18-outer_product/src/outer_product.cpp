@@ -0,0 +1,195 @@
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+#include "outer_product.hpp"
+
+#define ALIGNMENT 64
+
+// Kernel time in ms from the profiling information of the event
+double kernel_time(const sycl::event& e) {
+  double start = e.get_profiling_info<sycl::info::event_profiling::command_start>();
+  double end = e.get_profiling_info<sycl::info::event_profiling::command_end>();
+  return (end - start) * 1e-6;
+}
+
+bool check(const char* name, const float* result, const float* expected,
+           int rows, int cols, int ld) {
+  for (int i = 0; i < rows; i++)
+    for (int j = 0; j < cols; j++) {
+      float r = result[i * ld + j];
+      float e = expected[i * ld + j];
+      if (std::fabs(r - e) > 1e-4f * std::max(1.0f, std::fabs(e))) {
+        std::cout << name << ": element (" << i << "," << j << ") = " << r
+                  << ", expected " << e << std::endl;
+        return false;
+      }
+    }
+  return true;
+}
+
+void usage(const char* exe) {
+  std::cout << "Usage: \n" << exe << " [--rows M] [--cols N] [--alpha A]"
+            << "\n\nFAILED\n";
+}
+
+int main(int argc, char* argv[]) {
+  int m = 4096;
+  int n = 4096;
+  float alpha = 0.5f;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--rows") && i + 1 < argc) {
+      m = std::stoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--cols") && i + 1 < argc) {
+      n = std::stoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--alpha") && i + 1 < argc) {
+      alpha = std::stof(argv[++i]);
+    } else {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (m < 1 || n < 1) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  const int ld = leading_dimension(n);
+  const size_t elements = size_t(m) * ld;
+  float* host_x = new (std::align_val_t{ ALIGNMENT }) float[m];
+  float* host_y = new (std::align_val_t{ ALIGNMENT }) float[n];
+  float* host_a = new (std::align_val_t{ ALIGNMENT }) float[elements];
+  float* expected = new (std::align_val_t{ ALIGNMENT }) float[elements];
+  float* result = new (std::align_val_t{ ALIGNMENT }) float[elements];
+  for (int i = 0; i < m; i++) host_x[i] = (i % 13) * 0.25f;
+  for (int j = 0; j < n; j++) host_y[j] = (j % 11) * 0.125f - 0.5f;
+  for (size_t k = 0; k < elements; k++) host_a[k] = (k % 17) * 0.0625f;
+  for (int i = 0; i < m; i++)
+    for (int j = 0; j < ld; j++)
+      expected[i * ld + j] = host_a[i * ld + j] + (j < n ? alpha * host_x[i] * host_y[j] : 0.0f);
+
+  std::cout << "GER on a " << m << "x" << n << " matrix (leading dimension "
+            << ld << ")" << std::endl;
+
+  bool passed = true;
+  try {
+    // Use compile-time macros to select either:
+    //  - the FPGA emulator device (CPU emulation of the FPGA)
+    //  - the FPGA device (a real FPGA)
+    //  - the simulator device
+#if FPGA_SIMULATOR
+    auto selector = sycl::ext::intel::fpga_simulator_selector_v;
+#elif FPGA_HARDWARE
+    auto selector = sycl::ext::intel::fpga_selector_v;
+#else  // #if FPGA_EMULATOR
+    auto selector = sycl::ext::intel::fpga_emulator_selector_v;
+#endif
+
+    sycl::queue q(selector, sycl::property::queue::enable_profiling{});
+
+    auto device = q.get_device();
+    std::cout << "Running on device: "
+              << device.get_info<sycl::info::device::name>().c_str()
+              << std::endl;
+
+    const size_t bytes = elements * sizeof(float);
+    float* x = sycl::malloc_device<float>(m, q);
+    float* y = sycl::malloc_device<float>(n, q);
+    float* a = static_cast<float*>(sycl::aligned_alloc_device(ALIGNMENT, bytes, q));
+    float* norms = sycl::malloc_device<float>(m, q);
+    q.memcpy(x, host_x, m * sizeof(float)).wait();
+    q.memcpy(y, host_y, n * sizeof(float)).wait();
+
+    auto report = [&](const char* name, const sycl::event& e, double flops,
+                      double moved) {
+      double ms = kernel_time(e);
+      std::cout << std::setw(24) << name << ": " << std::fixed
+                << std::setprecision(3) << ms << " ms, "
+                << flops / (ms * 1e6) << " GFLOP/s, " << moved / (ms * 1e6)
+                << " GB/s, " << moved / 1e6 << " MB moved" << std::endl;
+    };
+    const double mn = double(m) * n;
+
+    // GER reads and writes A: 8 bytes and 3 flops per element
+    auto run = [&](const char* name, auto launch) {
+      q.memcpy(a, host_a, bytes).wait();
+      sycl::event e = launch();
+      e.wait();
+      q.memcpy(result, a, bytes).wait();
+      report(name, e, 3 * mn, 8 * mn);
+      passed &= check(name, result, expected, m, n, ld);
+    };
+    run("naive GER", [&]() { return naive_ger(q, m, n, alpha, x, y, a, ld); });
+    run("blocked GER", [&]() { return blocked_ger(q, m, n, alpha, x, y, a, ld); });
+
+    // reference row norms, of the updated matrix and of the outer product
+    std::vector<float> expected_norms(m), outer_norms(m), host_norms(m);
+    for (int i = 0; i < m; i++) {
+      double s = 0.0, o = 0.0;
+      for (int j = 0; j < n; j++) {
+        float v = alpha * host_x[i] * host_y[j];
+        s += double(host_a[i * ld + j] + v) * (host_a[i * ld + j] + v);
+        o += double(v) * v;
+      }
+      expected_norms[i] = s;
+      outer_norms[i] = o;
+    }
+    auto check_norms = [&](const char* name, const std::vector<float>& ref) {
+      q.memcpy(host_norms.data(), norms, m * sizeof(float)).wait();
+      for (int i = 0; i < m; i++)
+        if (std::fabs(host_norms[i] - ref[i]) > 1e-3f * std::max(1.0f, ref[i])) {
+          std::cout << name << ": row " << i << " = " << host_norms[i]
+                    << ", expected " << ref[i] << std::endl;
+          return false;
+        }
+      return true;
+    };
+
+    // fused: A is read once and nothing is written back
+    q.memcpy(a, host_a, bytes).wait();
+    sycl::event e = fused_ger_row_norms(q, m, n, alpha, x, y, a, ld, norms);
+    e.wait();
+    report("fused GER + row norms", e, 5 * mn, 4 * mn);
+    passed &= check_norms("fused GER + row norms", expected_norms);
+
+    // fused without A: only the two vectors are read
+    e = fused_ger_row_norms(q, m, n, alpha, x, y, nullptr, ld, norms);
+    e.wait();
+    report("fused outer + row norms", e, 4 * mn, 4.0 * (m + n));
+    passed &= check_norms("fused outer + row norms", outer_norms);
+
+    sycl::free(x, q);
+    sycl::free(y, q);
+    sycl::free(a, q);
+    sycl::free(norms, q);
+  } catch (sycl::exception const &e) {
+    // Catches exceptions in the host code.
+    std::cerr << "Caught a SYCL host exception:\n" << e.what() << "\n";
+
+    // Most likely the runtime couldn't find FPGA hardware!
+    if (e.code().value() == CL_DEVICE_NOT_FOUND) {
+      std::cerr << "If you are targeting an FPGA, please ensure that your "
+                   "system has a correctly configured FPGA board.\n";
+      std::cerr << "Run sys_check in the oneAPI root directory to verify.\n";
+      std::cerr << "If you are targeting the FPGA emulator, compile with "
+                   "-DFPGA_EMULATOR.\n";
+    }
+    std::terminate();
+  }
+
+  delete[] host_x;
+  delete[] host_y;
+  delete[] host_a;
+  delete[] expected;
+  delete[] result;
+
+  std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,117 @@
+#ifndef OUTER_PRODUCT_HPP
+#define OUTER_PRODUCT_HPP
+
+#include <vector>
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+////////////////////////////////////////////////////////////////////////
+//
+// Rank-1 update (GER): A (m x n) += alpha * x * y^T.
+//
+// A is stored row-major with a leading dimension ld, a multiple of
+// kBurst floats, so that every row starts on a burst boundary. The
+// blocked kernel works on kTileM x kTileN tiles: the kTileM elements of
+// x and the kTileN elements of y used by the tile are loaded once in
+// local memory, then every work-item updates one element. A work-group
+// writes kTileM row segments of kTileN consecutive floats, each starting
+// on a burst boundary.
+//
+////////////////////////////////////////////////////////////////////////
+// 64 bytes, the width of a memory burst
+constexpr int kBurst = 16;
+constexpr int kTileM = 4;
+constexpr int kTileN = 64;
+// Rows per work-group of the fused kernel
+constexpr int kFusedRows = 64;
+
+// Forward declare the kernel names in the global scope. This is an FPGA best
+// practice that reduces name mangling in the optimization reports.
+class NaiveGerID;
+class BlockedGerID;
+class FusedGerNormID;
+
+inline int round_up(int n, int m) { return (n + m - 1) / m * m; }
+
+// Leading dimension of a matrix with n columns
+inline int leading_dimension(int n) { return round_up(n, kBurst); }
+
+inline sycl::event naive_ger(sycl::queue& q, int m, int n, float alpha,
+                             const float* x, const float* y, float* a, int ld) {
+  return q.parallel_for<NaiveGerID>(sycl::range<2>(m, n), [=](sycl::id<2> idx) {
+    int i = idx[0];
+    int j = idx[1];
+    a[i * ld + j] += alpha * x[i] * y[j];
+  });
+}
+
+inline sycl::event blocked_ger(sycl::queue& q, int m, int n, float alpha,
+                               const float* x, const float* y, float* a, int ld) {
+  return q.submit([&](sycl::handler& h) {
+    sycl::local_accessor<float, 1> x_tile(sycl::range<1>(kTileM), h);
+    sycl::local_accessor<float, 1> y_tile(sycl::range<1>(kTileN), h);
+    sycl::nd_range<2> grid(sycl::range<2>(round_up(m, kTileM), round_up(n, kTileN)),
+                           sycl::range<2>(kTileM, kTileN));
+    h.parallel_for<BlockedGerID>(grid, [=](sycl::nd_item<2> item)
+        [[intel::kernel_args_restrict, sycl::reqd_work_group_size(kTileM, kTileN)]] {
+      int li = item.get_local_id(0);
+      int lj = item.get_local_id(1);
+      int i = item.get_global_id(0);
+      int j = item.get_global_id(1);
+      // the first row of work-items loads y, the first column loads x
+      if (li == 0) y_tile[lj] = (j < n) ? alpha * y[j] : 0.0f;
+      if (lj == 0) x_tile[li] = (i < m) ? x[i] : 0.0f;
+      sycl::group_barrier(item.get_group());
+
+      if (i < m && j < n) a[i * ld + j] += x_tile[li] * y_tile[lj];
+    });
+  });
+}
+
+////////////////////////////////////////////////////////////////////////
+//
+// Fused mode: the updated matrix is consumed as it is produced and never
+// written back. Here the consumer is a row reduction,
+//   norms[i] = sum_j (A[i][j] + alpha * x[i] * y[j])^2,
+// the squared row norms of the updated matrix. Without A (a == nullptr)
+// only the vectors are read: the m x n outer product is never
+// materialized. y is staged in local memory kTileN elements at a time
+// and shared by the kFusedRows rows of the work-group.
+//
+////////////////////////////////////////////////////////////////////////
+inline sycl::event fused_ger_row_norms(sycl::queue& q, int m, int n, float alpha,
+                                       const float* x, const float* y,
+                                       const float* a, int ld, float* norms) {
+  return q.submit([&](sycl::handler& h) {
+    sycl::local_accessor<float, 1> y_tile(sycl::range<1>(kTileN), h);
+    sycl::nd_range<1> grid(sycl::range<1>(round_up(m, kFusedRows)),
+                           sycl::range<1>(kFusedRows));
+    h.parallel_for<FusedGerNormID>(grid, [=](sycl::nd_item<1> item)
+        [[sycl::reqd_work_group_size(kFusedRows)]] {
+      int li = item.get_local_id(0);
+      int i = item.get_global_id(0);
+      float xi = (i < m) ? alpha * x[i] : 0.0f;
+      float sum = 0.0f;
+      for (int jb = 0; jb < n; jb += kTileN) {
+        // kFusedRows work-items load the kTileN elements of the block
+        for (int k = li; k < kTileN; k += kFusedRows)
+          y_tile[k] = (jb + k < n) ? y[jb + k] : 0.0f;
+        sycl::group_barrier(item.get_group());
+        if (i < m) {
+          #pragma unroll 8
+          for (int k = 0; k < kTileN; k++) {
+            float v = xi * y_tile[k];
+            if (a != nullptr && jb + k < n) v += a[i * ld + jb + k];
+            sum += v * v;
+          }
+        }
+        sycl::group_barrier(item.get_group());
+      }
+      if (i < m) norms[i] = sum;
+    });
+  });
+}
+
+#endif
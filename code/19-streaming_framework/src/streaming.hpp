@@ -0,0 +1,182 @@
+#ifndef STREAMING_HPP
+#define STREAMING_HPP
+
+#include <cstddef>
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+////////////////////////////////////////////////////////////////////////
+//
+// Streaming framework: source, transform and sink kernels connected by
+// pipes.
+//
+//   memory -> source -> [pipe] -> transform -> [pipe] -> ... -> sink -> memory
+//
+// Each kernel is a template on its pipes (and its kernel name), so
+// stages are chained by choosing the pipe types; the pipe depth is a
+// template parameter of the pipe. Device-side pipes connect kernels,
+// host pipes (experimental::pipe) connect a kernel to the host: the
+// host writes or reads them with Pipe::write(q, v) / Pipe::read(q).
+//
+// All the pipe accesses are non-blocking, so that each kernel can count
+// the iterations where its output pipe was full (backpressure from the
+// consumer) and where its input pipe was empty (starved by the
+// producer). The counters are written to a PipeStats in device memory
+// when the kernel ends.
+//
+// A Duty makes a kernel alternate between `active` iterations where it
+// uses its pipes and `idle` iterations where it does not, like a stage
+// with a bursty rate. Two bursty kernels out of phase only reach their
+// average rate when the pipe between them can absorb a burst, which is
+// what the depth sweep shows.
+//
+////////////////////////////////////////////////////////////////////////
+
+template <typename Id, typename T, int kDepth>
+using StreamPipe = sycl::ext::intel::pipe<Id, T, kDepth>;
+
+template <typename Id, typename T, int kDepth>
+using HostPipe = sycl::ext::intel::experimental::pipe<Id, T, kDepth>;
+
+struct PipeStats {
+  // writes refused because the pipe was full
+  unsigned long long full;
+  // reads that found the pipe empty
+  unsigned long long empty;
+};
+
+struct Duty {
+  int active = 1;
+  int idle = 0;
+  // first iteration in the active+idle period, active starts at 0
+  int phase = 0;
+};
+
+// Iteration counter of a Duty, one call per loop iteration
+class DutyCycle {
+ public:
+  explicit DutyCycle(Duty d) : duty_(d), t_(d.phase) {}
+  bool active() const { return t_ < duty_.active; }
+  void next() {
+    if (++t_ == duty_.active + duty_.idle) t_ = 0;
+  }
+
+ private:
+  Duty duty_;
+  int t_;
+};
+
+////////////////////////////////////////////////////////////////////////
+//
+// Source: count elements from device memory into Out. out_stats
+// receives the full count of Out.
+//
+////////////////////////////////////////////////////////////////////////
+template <typename Name, typename Out, typename T>
+sycl::event submit_source(sycl::queue& q, const T* in, size_t count, Duty duty,
+                          PipeStats* out_stats) {
+  return q.single_task<Name>([=]() [[intel::kernel_args_restrict]] {
+    DutyCycle cycle(duty);
+    unsigned long long full = 0;
+    size_t i = 0;
+    [[intel::initiation_interval(1)]]
+    while (i < count) {
+      if (cycle.active()) {
+        bool ok = false;
+        Out::write(in[i], ok);
+        if (ok) i++;
+        else full++;
+      }
+      cycle.next();
+    }
+    out_stats->full = full;
+  });
+}
+
+////////////////////////////////////////////////////////////////////////
+//
+// Transform: count elements from In, f applied, into Out. A read value
+// is held until Out accepts it.
+//
+////////////////////////////////////////////////////////////////////////
+template <typename Name, typename In, typename Out, typename F>
+sycl::event submit_transform(sycl::queue& q, size_t count, F f, Duty duty,
+                             PipeStats* in_stats, PipeStats* out_stats) {
+  return q.single_task<Name>([=]() {
+    DutyCycle cycle(duty);
+    unsigned long long full = 0, empty = 0;
+    size_t done = 0;
+    bool pending = false;
+    decltype(f(In::read())) value{};
+    [[intel::initiation_interval(1)]]
+    while (done < count) {
+      if (cycle.active()) {
+        if (!pending) {
+          bool ok = false;
+          auto v = In::read(ok);
+          if (ok) {
+            value = f(v);
+            pending = true;
+          } else {
+            empty++;
+          }
+        }
+        if (pending) {
+          bool ok = false;
+          Out::write(value, ok);
+          if (ok) {
+            pending = false;
+            done++;
+          } else {
+            full++;
+          }
+        }
+      }
+      cycle.next();
+    }
+    in_stats->empty = empty;
+    out_stats->full = full;
+  });
+}
+
+////////////////////////////////////////////////////////////////////////
+//
+// Sink: count elements from In into device memory. in_stats receives
+// the empty count of In.
+//
+////////////////////////////////////////////////////////////////////////
+template <typename Name, typename In, typename T>
+sycl::event submit_sink(sycl::queue& q, T* out, size_t count, Duty duty,
+                        PipeStats* in_stats) {
+  return q.single_task<Name>([=]() [[intel::kernel_args_restrict]] {
+    DutyCycle cycle(duty);
+    unsigned long long empty = 0;
+    size_t i = 0;
+    [[intel::initiation_interval(1)]]
+    while (i < count) {
+      if (cycle.active()) {
+        bool ok = false;
+        T v = In::read(ok);
+        if (ok) out[i++] = v;
+        else empty++;
+      }
+      cycle.next();
+    }
+    in_stats->empty = empty;
+  });
+}
+
+// Host side of host pipes, blocking
+template <typename Pipe, typename T>
+void feed_host_pipe(sycl::queue& q, const T* in, size_t count) {
+  for (size_t i = 0; i < count; i++) Pipe::write(q, in[i]);
+}
+
+template <typename Pipe, typename T>
+void drain_host_pipe(sycl::queue& q, T* out, size_t count) {
+  for (size_t i = 0; i < count; i++) out[i] = Pipe::read(q);
+}
+
+#endif
@@ -0,0 +1,220 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+#include "streaming.hpp"
+
+// Forward declare the kernel names in the global scope. This is an FPGA best
+// practice that reduces name mangling in the optimization reports.
+template <int kDepth> class SourceID;
+template <int kDepth> class TransformID;
+template <int kDepth> class SinkID;
+class HostTransformID;
+
+template <int kDepth, int kIndex> class DepthPipeID;
+class HostInPipeID;
+class HostOutPipeID;
+
+constexpr int kHostPipeDepth = 64;
+
+struct Scale {
+  int operator()(int v) const { return 3 * v + 1; }
+};
+
+// Time in ms from the first start to the last end of the events
+double span_time(const std::vector<sycl::event>& events) {
+  double start = 0.0, end = 0.0;
+  for (size_t i = 0; i < events.size(); i++) {
+    double s = events[i].get_profiling_info<sycl::info::event_profiling::command_start>();
+    double e = events[i].get_profiling_info<sycl::info::event_profiling::command_end>();
+    start = (i == 0) ? s : std::min(start, s);
+    end = (i == 0) ? e : std::max(end, e);
+  }
+  return (end - start) * 1e-6;
+}
+
+bool check(const char* name, const int* out, const int* in, size_t count) {
+  for (size_t i = 0; i < count; i++)
+    if (out[i] != Scale{}(in[i])) {
+      std::cout << name << ": element " << i << " = " << out[i]
+                << ", expected " << Scale{}(in[i]) << std::endl;
+      return false;
+    }
+  return true;
+}
+
+void usage(const char* exe) {
+  std::cout << "Usage: \n" << exe
+            << " [--count N] [--burst B] [--host-pipes]"
+               "\n\nFAILED\n";
+}
+
+////////////////////////////////////////////////////////////////////////
+//
+// One point of the depth sweep:
+//
+//   source (bursty) -> pipe 0 -> transform -> pipe 1 -> sink (bursty)
+//
+// The source and the sink are active for burst iterations out of
+// 2 * burst, out of phase: the sink is idle while the source produces.
+// Both pipes have depth kDepth.
+//
+////////////////////////////////////////////////////////////////////////
+template <int kDepth>
+bool run_depth(sycl::queue& q, const int* in, int* out, const int* host_in,
+               int* host_out, size_t count, int burst, PipeStats* stats) {
+  using Pipe0 = StreamPipe<DepthPipeID<kDepth, 0>, int, kDepth>;
+  using Pipe1 = StreamPipe<DepthPipeID<kDepth, 1>, int, kDepth>;
+  const Duty source{burst, burst, 0};
+  const Duty sink{burst, burst, burst};
+
+  q.memset(stats, 0, 2 * sizeof(PipeStats)).wait();
+  q.memset(out, 0, count * sizeof(int)).wait();
+  std::vector<sycl::event> events;
+  events.push_back(submit_source<SourceID<kDepth>, Pipe0>(q, in, count, source, &stats[0]));
+  events.push_back(submit_transform<TransformID<kDepth>, Pipe0, Pipe1>(
+      q, count, Scale{}, Duty{}, &stats[0], &stats[1]));
+  events.push_back(submit_sink<SinkID<kDepth>, Pipe1>(q, out, count, sink, &stats[1]));
+  q.wait();
+
+  PipeStats host_stats[2];
+  q.memcpy(host_stats, stats, sizeof(host_stats)).wait();
+  q.memcpy(host_out, out, count * sizeof(int)).wait();
+  double ms = span_time(events);
+  std::cout << std::setw(6) << kDepth << std::setw(12) << std::fixed
+            << std::setprecision(3) << ms << std::setw(12) << count / (ms * 1e3);
+  for (const PipeStats& s : host_stats)
+    std::cout << std::setw(12) << s.full << std::setw(12) << s.empty;
+  std::cout << std::endl;
+  return check("depth sweep", host_out, host_in, count);
+}
+
+template <int... kDepths>
+bool sweep(sycl::queue& q, const int* in, int* out, const int* host_in,
+           int* host_out, size_t count, int burst, PipeStats* stats) {
+  std::cout << std::setw(6) << "depth" << std::setw(12) << "ms" << std::setw(12)
+            << "Mitems/s" << std::setw(12) << "p0 full" << std::setw(12)
+            << "p0 empty" << std::setw(12) << "p1 full" << std::setw(12)
+            << "p1 empty" << std::endl;
+  bool passed = true;
+  ((passed &= run_depth<kDepths>(q, in, out, host_in, host_out, count, burst, stats)), ...);
+  return passed;
+}
+
+////////////////////////////////////////////////////////////////////////
+//
+// Host pipes: the host feeds the transform from one thread and drains
+// its output from another, without any device memory.
+//
+////////////////////////////////////////////////////////////////////////
+bool run_host_pipes(sycl::queue& q, const int* host_in, int* host_out,
+                    size_t count, PipeStats* stats) {
+  using HostIn = HostPipe<HostInPipeID, int, kHostPipeDepth>;
+  using HostOut = HostPipe<HostOutPipeID, int, kHostPipeDepth>;
+
+  std::fill(host_out, host_out + count, 0);
+  q.memset(stats, 0, 2 * sizeof(PipeStats)).wait();
+  auto start = std::chrono::steady_clock::now();
+  std::thread feeder([&]() { feed_host_pipe<HostIn>(q, host_in, count); });
+  sycl::event e = submit_transform<HostTransformID, HostIn, HostOut>(
+      q, count, Scale{}, Duty{}, &stats[0], &stats[1]);
+  drain_host_pipe<HostOut>(q, host_out, count);
+  feeder.join();
+  e.wait();
+  double ms = std::chrono::duration<double, std::milli>(
+                  std::chrono::steady_clock::now() - start).count();
+
+  PipeStats host_stats[2];
+  q.memcpy(host_stats, stats, sizeof(host_stats)).wait();
+  std::cout << "Host pipes: " << std::fixed << std::setprecision(3) << ms
+            << " ms, " << count / (ms * 1e3) << " Mitems/s, input empty "
+            << host_stats[0].empty << ", output full " << host_stats[1].full
+            << std::endl;
+  return check("host pipes", host_out, host_in, count);
+}
+
+int main(int argc, char* argv[]) {
+  size_t count = 1 << 20;
+  int burst = 64;
+  bool host_pipes = false;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--count") && i + 1 < argc) {
+      count = std::stoul(argv[++i]);
+    } else if (!strcmp(argv[i], "--burst") && i + 1 < argc) {
+      burst = std::stoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--host-pipes")) {
+      host_pipes = true;
+    } else {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (count < 1 || burst < 1) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  bool passed = true;
+  try {
+    // Use compile-time macros to select either:
+    //  - the FPGA emulator device (CPU emulation of the FPGA)
+    //  - the FPGA device (a real FPGA)
+    //  - the simulator device
+#if FPGA_SIMULATOR
+    auto selector = sycl::ext::intel::fpga_simulator_selector_v;
+#elif FPGA_HARDWARE
+    auto selector = sycl::ext::intel::fpga_selector_v;
+#else  // #if FPGA_EMULATOR
+    auto selector = sycl::ext::intel::fpga_emulator_selector_v;
+#endif
+
+    sycl::queue q(selector, sycl::property::queue::enable_profiling{});
+
+    auto device = q.get_device();
+    std::cout << "Running on device: "
+              << device.get_info<sycl::info::device::name>().c_str()
+              << std::endl;
+
+    std::vector<int> host_in(count), host_out(count);
+    for (size_t i = 0; i < count; i++) host_in[i] = static_cast<int>(i % 100003);
+    int* in = sycl::malloc_device<int>(count, q);
+    int* out = sycl::malloc_device<int>(count, q);
+    PipeStats* stats = sycl::malloc_device<PipeStats>(2, q);
+    q.memcpy(in, host_in.data(), count * sizeof(int)).wait();
+
+    std::cout << count << " elements, bursts of " << burst << std::endl;
+    passed &= sweep<1, 2, 4, 8, 16, 32, 64, 128, 256, 512>(
+        q, in, out, host_in.data(), host_out.data(), count, burst, stats);
+    if (host_pipes)
+      passed &= run_host_pipes(q, host_in.data(), host_out.data(), count, stats);
+
+    sycl::free(in, q);
+    sycl::free(out, q);
+    sycl::free(stats, q);
+  } catch (sycl::exception const &e) {
+    // Catches exceptions in the host code.
+    std::cerr << "Caught a SYCL host exception:\n" << e.what() << "\n";
+
+    // Most likely the runtime couldn't find FPGA hardware!
+    if (e.code().value() == CL_DEVICE_NOT_FOUND) {
+      std::cerr << "If you are targeting an FPGA, please ensure that your "
+                   "system has a correctly configured FPGA board.\n";
+      std::cerr << "Run sys_check in the oneAPI root directory to verify.\n";
+      std::cerr << "If you are targeting the FPGA emulator, compile with "
+                   "-DFPGA_EMULATOR.\n";
+    }
+    std::terminate();
+  }
+
+  std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,230 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+////////////////////////////////////////////////////////////////////////
+//
+// Low-latency host to kernel streaming with host pipes.
+//
+// A persistent kernel is launched once and waits on a host pipe. The
+// host pushes each message as a header packet (number of payload
+// packets) followed by the payload, while the kernel is already running;
+// the kernel streams the processed packets back through a second host
+// pipe. A header with 0 packets stops the kernel. No buffer, no memcpy
+// and no kernel launch happen per message.
+//
+// The baseline does what the other samples do for every request: copy
+// the message to device memory, launch a kernel, copy the result back.
+//
+// The host writes a whole message before reading the response, so the
+// output pipe must hold kMaxPackets + 1 packets.
+//
+////////////////////////////////////////////////////////////////////////
+constexpr int kPacketInts = 16;  // 64 bytes per pipe transaction
+constexpr int kMaxPackets = 256;  // messages up to 16 KiB
+constexpr int kPipeDepth = kMaxPackets + 1;
+
+struct Packet {
+  int data[kPacketInts];
+};
+
+// Forward declare the kernel names in the global scope. This is an FPGA best
+// practice that reduces name mangling in the optimization reports.
+class PersistentID;
+class PerMessageID;
+
+using RequestPipe = sycl::ext::intel::experimental::pipe<class RequestPipeID, Packet, kPipeDepth>;
+using ResponsePipe = sycl::ext::intel::experimental::pipe<class ResponsePipeID, Packet, kPipeDepth>;
+
+// The work done on every payload packet
+inline Packet process(const Packet& in) {
+  Packet out;
+  #pragma unroll
+  for (int k = 0; k < kPacketInts; k++) out.data[k] = 2 * in.data[k] + 1;
+  return out;
+}
+
+sycl::event launch_persistent(sycl::queue& q) {
+  return q.single_task<PersistentID>([=]() {
+    while (true) {
+      Packet header = RequestPipe::read();
+      int packets = header.data[0];
+      if (packets == 0) break;
+      ResponsePipe::write(header);
+      for (int i = 0; i < packets; i++) ResponsePipe::write(process(RequestPipe::read()));
+    }
+  });
+}
+
+sycl::event launch_per_message(sycl::queue& q, const Packet* in, Packet* out,
+                               int packets, const sycl::event& copy_in) {
+  return q.submit([&](sycl::handler& h) {
+    h.depends_on(copy_in);
+    h.single_task<PerMessageID>([=]() [[intel::kernel_args_restrict]] {
+      for (int i = 0; i < packets; i++) out[i] = process(in[i]);
+    });
+  });
+}
+
+struct Latency {
+  double p50, p99, mean;
+};
+
+// Percentiles of the samples in microseconds
+Latency percentiles(std::vector<double>& us) {
+  std::sort(us.begin(), us.end());
+  double sum = 0.0;
+  for (double v : us) sum += v;
+  auto at = [&](double p) { return us[std::min(us.size() - 1, size_t(p * us.size()))]; };
+  return {at(0.50), at(0.99), sum / us.size()};
+}
+
+bool check(const char* name, const std::vector<Packet>& in,
+           const std::vector<Packet>& out, int packets) {
+  for (int i = 0; i < packets; i++)
+    for (int k = 0; k < kPacketInts; k++)
+      if (out[i].data[k] != 2 * in[i].data[k] + 1) {
+        std::cout << name << ": packet " << i << " word " << k << " = "
+                  << out[i].data[k] << ", expected " << 2 * in[i].data[k] + 1
+                  << std::endl;
+        return false;
+      }
+  return true;
+}
+
+void usage(const char* exe) {
+  std::cout << "Usage: \n" << exe << " [--messages N] [--warmup W]"
+            << "\n\nFAILED\n";
+}
+
+int main(int argc, char* argv[]) {
+  int messages = 1000;
+  int warmup = 50;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--messages") && i + 1 < argc) {
+      messages = std::stoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--warmup") && i + 1 < argc) {
+      warmup = std::stoi(argv[++i]);
+    } else {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (messages < 1 || warmup < 0) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  bool passed = true;
+  try {
+    // Use compile-time macros to select either:
+    //  - the FPGA emulator device (CPU emulation of the FPGA)
+    //  - the FPGA device (a real FPGA)
+    //  - the simulator device
+#if FPGA_SIMULATOR
+    auto selector = sycl::ext::intel::fpga_simulator_selector_v;
+#elif FPGA_HARDWARE
+    auto selector = sycl::ext::intel::fpga_selector_v;
+#else  // #if FPGA_EMULATOR
+    auto selector = sycl::ext::intel::fpga_emulator_selector_v;
+#endif
+
+    sycl::queue q(selector);
+
+    auto device = q.get_device();
+    std::cout << "Running on device: "
+              << device.get_info<sycl::info::device::name>().c_str()
+              << std::endl;
+
+    const std::vector<int> sizes = {64, 256, 1024, 4096, 16384};
+    std::vector<Packet> in(kMaxPackets), out(kMaxPackets);
+    for (int i = 0; i < kMaxPackets; i++)
+      for (int k = 0; k < kPacketInts; k++) in[i].data[k] = i * kPacketInts + k;
+
+    Packet* device_in = sycl::malloc_device<Packet>(kMaxPackets, q);
+    Packet* device_out = sycl::malloc_device<Packet>(kMaxPackets, q);
+
+    std::cout << std::setw(10) << "bytes" << std::setw(24) << "mode"
+              << std::setw(12) << "p50 us" << std::setw(12) << "p99 us"
+              << std::setw(12) << "mean us" << std::endl;
+    auto report = [&](int bytes, const char* mode, std::vector<double>& us) {
+      Latency l = percentiles(us);
+      std::cout << std::setw(10) << bytes << std::setw(24) << mode << std::fixed
+                << std::setprecision(2) << std::setw(12) << l.p50
+                << std::setw(12) << l.p99 << std::setw(12) << l.mean
+                << std::endl;
+    };
+
+    // the kernel is running from here on
+    sycl::event persistent = launch_persistent(q);
+
+    for (int bytes : sizes) {
+      const int packets = bytes / int(sizeof(Packet));
+      std::vector<double> us;
+      for (int m = 0; m < warmup + messages; m++) {
+        Packet header{};
+        header.data[0] = packets;
+        auto start = std::chrono::steady_clock::now();
+        RequestPipe::write(q, header);
+        for (int i = 0; i < packets; i++) RequestPipe::write(q, in[i]);
+        Packet echo = ResponsePipe::read(q);
+        for (int i = 0; i < packets; i++) out[i] = ResponsePipe::read(q);
+        auto end = std::chrono::steady_clock::now();
+        if (m >= warmup)
+          us.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+        passed &= echo.data[0] == packets;
+      }
+      report(bytes, "host pipes", us);
+      passed &= check("host pipes", in, out, packets);
+    }
+
+    // stop the persistent kernel
+    Packet stop{};
+    RequestPipe::write(q, stop);
+    persistent.wait();
+
+    for (int bytes : sizes) {
+      const int packets = bytes / int(sizeof(Packet));
+      std::vector<double> us;
+      for (int m = 0; m < warmup + messages; m++) {
+        std::fill(out.begin(), out.end(), Packet{});
+        auto start = std::chrono::steady_clock::now();
+        sycl::event copy_in = q.memcpy(device_in, in.data(), packets * sizeof(Packet));
+        sycl::event kernel = launch_per_message(q, device_in, device_out, packets, copy_in);
+        q.memcpy(out.data(), device_out, packets * sizeof(Packet), kernel).wait();
+        auto end = std::chrono::steady_clock::now();
+        if (m >= warmup)
+          us.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+      }
+      report(bytes, "memcpy + launch", us);
+      passed &= check("memcpy + launch", in, out, packets);
+    }
+
+    sycl::free(device_in, q);
+    sycl::free(device_out, q);
+  } catch (sycl::exception const &e) {
+    // Catches exceptions in the host code.
+    std::cerr << "Caught a SYCL host exception:\n" << e.what() << "\n";
+
+    // Most likely the runtime couldn't find FPGA hardware!
+    if (e.code().value() == CL_DEVICE_NOT_FOUND) {
+      std::cerr << "If you are targeting an FPGA, please ensure that your "
+                   "system has a correctly configured FPGA board.\n";
+      std::cerr << "Run sys_check in the oneAPI root directory to verify.\n";
+      std::cerr << "If you are targeting the FPGA emulator, compile with "
+                   "-DFPGA_EMULATOR.\n";
+    }
+    std::terminate();
+  }
+
+  std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
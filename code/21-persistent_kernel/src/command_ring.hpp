@@ -0,0 +1,112 @@
+#ifndef COMMAND_RING_HPP
+#define COMMAND_RING_HPP
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+////////////////////////////////////////////////////////////////////////
+//
+// Persistent kernel fed by a command ring in host USM.
+//
+// The host writes work descriptors in the ring and publishes them by
+// incrementing head. A single_task launched once polls head, executes
+// the new commands in order and publishes their completion by
+// incrementing done. head and done are only accessed through atomics
+// with system scope, so the kernel never reads a stale copy of head and
+// the host never sees done before the results. They sit on separate
+// cache lines as each one has a single writer.
+//
+// The host may run kRingSize commands ahead of the kernel. A kStop
+// command ends the kernel.
+//
+////////////////////////////////////////////////////////////////////////
+constexpr unsigned kRingSize = 64;
+
+enum Op : int { kStop = 0, kAdd = 1, kScale = 2 };
+
+// kAdd:   dst[i] = a[i] + b[i]
+// kScale: dst[i] = scalar * a[i]
+struct Command {
+  int op;
+  int length;
+  float scalar;
+  const float* a;
+  const float* b;
+  float* dst;
+};
+
+struct CommandRing {
+  alignas(64) unsigned head;
+  alignas(64) unsigned done;
+  alignas(64) Command commands[kRingSize];
+};
+
+using RingCounter = sycl::atomic_ref<unsigned, sycl::memory_order::acq_rel,
+                                     sycl::memory_scope::system,
+                                     sycl::access::address_space::global_space>;
+
+// The host rewrites a slot every kRingSize commands: the kernel reads the
+// slots through a load-store unit without cache so it never sees a stale one
+using UncachedLSU = sycl::ext::intel::lsu<sycl::ext::intel::cache<0>>;
+
+// Forward declare the kernel name in the global scope. This is an FPGA best
+// practice that reduces name mangling in the optimization reports.
+class PersistentKernelID;
+
+inline sycl::event launch_persistent(sycl::queue& q, CommandRing* ring) {
+  return q.single_task<PersistentKernelID>([=]() {
+    RingCounter head(ring->head);
+    RingCounter done(ring->done);
+    unsigned tail = 0;
+    bool running = true;
+    while (running) {
+      // poll for the next command
+      if (head.load(sycl::memory_order::acquire) == tail) continue;
+      Command c = UncachedLSU::load(
+          sycl::address_space_cast<sycl::access::address_space::global_space,
+                                   sycl::access::decorated::no>(
+              &ring->commands[tail % kRingSize]));
+      if (c.op == kStop) {
+        running = false;
+      } else {
+        [[intel::initiation_interval(1)]]
+        for (int i = 0; i < c.length; i++)
+          c.dst[i] = (c.op == kAdd) ? c.a[i] + c.b[i] : c.scalar * c.a[i];
+      }
+      sycl::atomic_fence(sycl::memory_order::release, sycl::memory_scope::system);
+      done.store(++tail, sycl::memory_order::release);
+    }
+  });
+}
+
+// Host side of the ring
+class RingClient {
+ public:
+  explicit RingClient(CommandRing* ring) : ring_(ring) {}
+
+  // Post a command, waiting for a free slot; returns its sequence number
+  unsigned post(const Command& c) {
+    unsigned seq = posted_;
+    while (seq - RingCounter(ring_->done).load(sycl::memory_order::acquire) >= kRingSize) {
+    }
+    ring_->commands[seq % kRingSize] = c;
+    RingCounter(ring_->head).store(seq + 1, sycl::memory_order::release);
+    posted_++;
+    return seq;
+  }
+
+  // Wait until the command seq has completed
+  void wait(unsigned seq) {
+    while (RingCounter(ring_->done).load(sycl::memory_order::acquire) <= seq) {
+    }
+  }
+
+  void stop() { wait(post(Command{kStop, 0, 0.0f, nullptr, nullptr, nullptr})); }
+
+ private:
+  CommandRing* ring_;
+  unsigned posted_ = 0;
+};
+
+#endif
@@ -0,0 +1,179 @@
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+#include "command_ring.hpp"
+
+// Forward declare the kernel name in the global scope. This is an FPGA best
+// practice that reduces name mangling in the optimization reports.
+class PerJobID;
+
+// Job j: kAdd for even j, kScale for odd j, on its own slice of out
+Command make_job(int j, int length, const float* a, const float* b, float* out) {
+  return Command{(j % 2) ? kScale : kAdd, length, 0.5f * (j % 7), a, b,
+                 out + size_t(j) * length};
+}
+
+bool check(const char* name, const std::vector<float>& out,
+           const std::vector<float>& a, const std::vector<float>& b, int jobs,
+           int length) {
+  for (int j = 0; j < jobs; j++)
+    for (int i = 0; i < length; i++) {
+      float expected = (j % 2) ? 0.5f * (j % 7) * a[i] : a[i] + b[i];
+      float result = out[size_t(j) * length + i];
+      if (result != expected) {
+        std::cout << name << ": job " << j << " element " << i << " = "
+                  << result << ", expected " << expected << std::endl;
+        return false;
+      }
+    }
+  return true;
+}
+
+void usage(const char* exe) {
+  std::cout << "Usage: \n" << exe << " [--jobs N] [--length L]"
+            << "\n\nFAILED\n";
+}
+
+int main(int argc, char* argv[]) {
+  int jobs = 10000;
+  int length = 16;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--jobs") && i + 1 < argc) {
+      jobs = std::stoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--length") && i + 1 < argc) {
+      length = std::stoi(argv[++i]);
+    } else {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (jobs < 1 || length < 1) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  bool passed = true;
+  try {
+    // Use compile-time macros to select either:
+    //  - the FPGA emulator device (CPU emulation of the FPGA)
+    //  - the FPGA device (a real FPGA)
+    //  - the simulator device
+#if FPGA_SIMULATOR
+    auto selector = sycl::ext::intel::fpga_simulator_selector_v;
+#elif FPGA_HARDWARE
+    auto selector = sycl::ext::intel::fpga_selector_v;
+#else  // #if FPGA_EMULATOR
+    auto selector = sycl::ext::intel::fpga_emulator_selector_v;
+#endif
+
+    sycl::queue q(selector);
+
+    auto device = q.get_device();
+    std::cout << "Running on device: "
+              << device.get_info<sycl::info::device::name>().c_str()
+              << std::endl;
+
+    std::vector<float> host_a(length), host_b(length);
+    std::vector<float> host_out(size_t(jobs) * length);
+    for (int i = 0; i < length; i++) {
+      host_a[i] = i;
+      host_b[i] = 2 * i + 1;
+    }
+    const size_t out_bytes = host_out.size() * sizeof(float);
+    float* a = sycl::malloc_device<float>(length, q);
+    float* b = sycl::malloc_device<float>(length, q);
+    float* out = sycl::malloc_device<float>(host_out.size(), q);
+    q.memcpy(a, host_a.data(), length * sizeof(float)).wait();
+    q.memcpy(b, host_b.data(), length * sizeof(float)).wait();
+
+    CommandRing* ring = sycl::malloc_host<CommandRing>(1, q);
+    std::memset(ring, 0, sizeof(CommandRing));
+
+    auto report = [&](const char* name, double seconds) {
+      std::cout << std::setw(32) << name << ": " << std::fixed
+                << std::setprecision(3) << seconds * 1e3 << " ms, "
+                << jobs / seconds << " jobs/s, " << seconds * 1e6 / jobs
+                << " us/job" << std::endl;
+    };
+    auto verify = [&](const char* name) {
+      q.memcpy(host_out.data(), out, out_bytes).wait();
+      passed &= check(name, host_out, host_a, host_b, jobs, length);
+      q.memset(out, 0, out_bytes).wait();
+    };
+    using clock = std::chrono::steady_clock;
+
+    std::cout << jobs << " jobs of " << length << " floats" << std::endl;
+
+    // persistent kernel: launched once for both ring benchmarks
+    sycl::event persistent = launch_persistent(q, ring);
+    RingClient client(ring);
+
+    // the host runs up to kRingSize jobs ahead
+    auto start = clock::now();
+    unsigned last = 0;
+    for (int j = 0; j < jobs; j++) last = client.post(make_job(j, length, a, b, out));
+    client.wait(last);
+    report("ring, streamed", std::chrono::duration<double>(clock::now() - start).count());
+    verify("ring, streamed");
+
+    // one job at a time: round trip of a command
+    start = clock::now();
+    for (int j = 0; j < jobs; j++) client.wait(client.post(make_job(j, length, a, b, out)));
+    report("ring, one job at a time", std::chrono::duration<double>(clock::now() - start).count());
+    verify("ring, one job at a time");
+
+    client.stop();
+    persistent.wait();
+
+    // a kernel launch per job
+    auto submit_job = [&](int j) {
+      Command c = make_job(j, length, a, b, out);
+      return q.submit([&](sycl::handler& h) {
+        h.single_task<PerJobID>([=]() {
+          for (int i = 0; i < c.length; i++)
+            c.dst[i] = (c.op == kAdd) ? c.a[i] + c.b[i] : c.scalar * c.a[i];
+        });
+      });
+    };
+
+    start = clock::now();
+    for (int j = 0; j < jobs; j++) submit_job(j);
+    q.wait();
+    report("q.submit per job", std::chrono::duration<double>(clock::now() - start).count());
+    verify("q.submit per job");
+
+    start = clock::now();
+    for (int j = 0; j < jobs; j++) submit_job(j).wait();
+    report("q.submit per job, waited", std::chrono::duration<double>(clock::now() - start).count());
+    verify("q.submit per job, waited");
+
+    sycl::free(a, q);
+    sycl::free(b, q);
+    sycl::free(out, q);
+    sycl::free(ring, q);
+  } catch (sycl::exception const &e) {
+    // Catches exceptions in the host code.
+    std::cerr << "Caught a SYCL host exception:\n" << e.what() << "\n";
+
+    // Most likely the runtime couldn't find FPGA hardware!
+    if (e.code().value() == CL_DEVICE_NOT_FOUND) {
+      std::cerr << "If you are targeting an FPGA, please ensure that your "
+                   "system has a correctly configured FPGA board.\n";
+      std::cerr << "Run sys_check in the oneAPI root directory to verify.\n";
+      std::cerr << "If you are targeting the FPGA emulator, compile with "
+                   "-DFPGA_EMULATOR.\n";
+    }
+    std::terminate();
+  }
+
+  std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,293 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+////////////////////////////////////////////////////////////////////////
+//
+// Launch overhead microbenchmarks.
+//
+//  - submit:     cost of q.submit of an empty kernel, and submit + wait
+//  - throughput: empty kernels per second, in-order vs out-of-order queue
+//  - sync:       q.wait() vs event.wait() vs host_accessor after a kernel
+//  - dependency: chain of kernels on one buffer (tracked by the runtime)
+//                vs the same chain on USM with an in-order queue
+//  - memcpy:     USM host<->device copy latency by size
+//
+// Every measurement is repeated and reported as p50/p99/mean in
+// microseconds, on the console and optionally as CSV and JSON, so that
+// the emulator and the board can be compared.
+//
+////////////////////////////////////////////////////////////////////////
+
+// Forward declare the kernel names in the global scope. This is an FPGA best
+// practice that reduces name mangling in the optimization reports.
+class EmptyID;
+class WriteUsmQueueWaitID;
+class WriteUsmEventWaitID;
+class WriteAccessorID;
+class BufferChainID;
+class UsmChainID;
+
+struct Result {
+  std::string benchmark;
+  std::string variant;
+  size_t bytes;
+  double p50_us;
+  double p99_us;
+  double mean_us;
+};
+
+using Clock = std::chrono::steady_clock;
+
+double elapsed_us(Clock::time_point start) {
+  return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+Result summarize(const std::string& benchmark, const std::string& variant,
+                 size_t bytes, std::vector<double> us) {
+  std::sort(us.begin(), us.end());
+  double sum = 0.0;
+  for (double v : us) sum += v;
+  auto at = [&](double p) { return us[std::min(us.size() - 1, size_t(p * us.size()))]; };
+  return {benchmark, variant, bytes, at(0.50), at(0.99), sum / us.size()};
+}
+
+// Time f() repeat times, after a few untimed calls
+template <typename F>
+Result measure(const std::string& benchmark, const std::string& variant,
+               size_t bytes, int repeat, F f) {
+  for (int i = 0; i < 5; i++) f();
+  std::vector<double> us;
+  for (int i = 0; i < repeat; i++) {
+    auto start = Clock::now();
+    f();
+    us.push_back(elapsed_us(start));
+  }
+  return summarize(benchmark, variant, bytes, us);
+}
+
+sycl::event submit_empty(sycl::queue& q) {
+  return q.submit([&](sycl::handler& h) { h.single_task<EmptyID>([=]() {}); });
+}
+
+void write_csv(const std::string& path, const std::string& device,
+               const std::vector<Result>& results) {
+  std::ofstream file(path);
+  file << "device,benchmark,variant,bytes,p50_us,p99_us,mean_us\n";
+  for (const Result& r : results)
+    file << "\"" << device << "\"," << r.benchmark << "," << r.variant << ","
+         << r.bytes << "," << r.p50_us << "," << r.p99_us << "," << r.mean_us
+         << "\n";
+}
+
+void write_json(const std::string& path, const std::string& device,
+                const std::vector<Result>& results) {
+  std::ofstream file(path);
+  file << "{\n  \"device\": \"" << device << "\",\n  \"results\": [\n";
+  for (size_t i = 0; i < results.size(); i++) {
+    const Result& r = results[i];
+    file << "    {\"benchmark\": \"" << r.benchmark << "\", \"variant\": \""
+         << r.variant << "\", \"bytes\": " << r.bytes << ", \"p50_us\": "
+         << r.p50_us << ", \"p99_us\": " << r.p99_us << ", \"mean_us\": "
+         << r.mean_us << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+  }
+  file << "  ]\n}\n";
+}
+
+void usage(const char* exe) {
+  std::cout << "Usage: \n" << exe
+            << " [--repeat N] [--batch B] [--max-bytes M] [--csv <file>]"
+               " [--json <file>]"
+               "\n\nFAILED\n";
+}
+
+int main(int argc, char* argv[]) {
+  int repeat = 1000;
+  int batch = 100;
+  size_t max_bytes = size_t(64) << 20;
+  std::string csv_path, json_path;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--repeat") && i + 1 < argc) {
+      repeat = std::stoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--batch") && i + 1 < argc) {
+      batch = std::stoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--max-bytes") && i + 1 < argc) {
+      max_bytes = std::stoull(argv[++i]);
+    } else if (!strcmp(argv[i], "--csv") && i + 1 < argc) {
+      csv_path = argv[++i];
+    } else if (!strcmp(argv[i], "--json") && i + 1 < argc) {
+      json_path = argv[++i];
+    } else {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (repeat < 1 || batch < 1 || max_bytes < 4) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  bool passed = true;
+  try {
+    // Use compile-time macros to select either:
+    //  - the FPGA emulator device (CPU emulation of the FPGA)
+    //  - the FPGA device (a real FPGA)
+    //  - the simulator device
+#if FPGA_SIMULATOR
+    auto selector = sycl::ext::intel::fpga_simulator_selector_v;
+#elif FPGA_HARDWARE
+    auto selector = sycl::ext::intel::fpga_selector_v;
+#else  // #if FPGA_EMULATOR
+    auto selector = sycl::ext::intel::fpga_emulator_selector_v;
+#endif
+
+    sycl::queue q(selector);
+    sycl::queue in_order(q.get_context(), q.get_device(),
+                         sycl::property::queue::in_order{});
+
+    auto device = q.get_device();
+    std::string device_name = device.get_info<sycl::info::device::name>();
+    std::cout << "Running on device: " << device_name << std::endl;
+
+    std::vector<Result> results;
+
+    // submit latency
+    results.push_back(measure("submit", "submit only", 0, repeat, [&]() {
+      submit_empty(q);
+    }));
+    q.wait();
+    results.push_back(measure("submit", "submit + wait", 0, repeat, [&]() {
+      submit_empty(q).wait();
+    }));
+
+    // throughput: batch kernels, time per kernel
+    auto throughput = [&](sycl::queue& queue, const char* variant) {
+      Result r = measure("throughput", variant, 0, std::max(1, repeat / batch), [&]() {
+        for (int i = 0; i < batch; i++) submit_empty(queue);
+        queue.wait();
+      });
+      r.p50_us /= batch;
+      r.p99_us /= batch;
+      r.mean_us /= batch;
+      results.push_back(r);
+    };
+    throughput(q, "out-of-order");
+    throughput(in_order, "in-order");
+
+    // synchronization after a kernel writing one int
+    int value = 0;
+    int* usm_value = sycl::malloc_device<int>(1, q);
+    results.push_back(measure("sync", "q.wait", 0, repeat, [&]() {
+      q.single_task<WriteUsmQueueWaitID>([=]() { *usm_value = 1; });
+      q.wait();
+    }));
+    results.push_back(measure("sync", "event.wait", 0, repeat, [&]() {
+      q.single_task<WriteUsmEventWaitID>([=]() { *usm_value = 1; }).wait();
+    }));
+    {
+      sycl::buffer<int, 1> buffer(&value, sycl::range<1>(1));
+      results.push_back(measure("sync", "host_accessor", 0, repeat, [&]() {
+        q.submit([&](sycl::handler& h) {
+          sycl::accessor acc{buffer, h, sycl::write_only, sycl::no_init};
+          h.single_task<WriteAccessorID>([=]() { acc[0] = 1; });
+        });
+        sycl::host_accessor host{buffer, sycl::read_only};
+        passed &= host[0] == 1;
+      }));
+    }
+
+    // dependency tracking: batch kernels incrementing the same counter
+    const int chain_length = (5 + std::max(1, repeat / batch)) * batch;
+    int count = 0;
+    {
+      sycl::buffer<int, 1> buffer(&count, sycl::range<1>(1));
+      Result r = measure("dependency", "buffer accessors", 0,
+                         std::max(1, repeat / batch), [&]() {
+        for (int i = 0; i < batch; i++)
+          q.submit([&](sycl::handler& h) {
+            sycl::accessor acc{buffer, h, sycl::read_write};
+            h.single_task<BufferChainID>([=]() { acc[0]++; });
+          });
+        q.wait();
+      });
+      r.p50_us /= batch;
+      r.p99_us /= batch;
+      r.mean_us /= batch;
+      results.push_back(r);
+    }
+    passed &= count == chain_length;
+    in_order.memset(usm_value, 0, sizeof(int)).wait();
+    {
+      Result r = measure("dependency", "usm in-order", 0,
+                         std::max(1, repeat / batch), [&]() {
+        for (int i = 0; i < batch; i++)
+          in_order.single_task<UsmChainID>([=]() { (*usm_value)++; });
+        in_order.wait();
+      });
+      r.p50_us /= batch;
+      r.p99_us /= batch;
+      r.mean_us /= batch;
+      results.push_back(r);
+    }
+    int chained = 0;
+    in_order.memcpy(&chained, usm_value, sizeof(int)).wait();
+    passed &= chained == chain_length;
+    sycl::free(usm_value, q);
+
+    // USM memcpy latency by size
+    char* host = sycl::malloc_host<char>(max_bytes, q);
+    char* dev = sycl::malloc_device<char>(max_bytes, q);
+    std::memset(host, 1, max_bytes);
+    for (size_t bytes = 4; bytes <= max_bytes; bytes *= 4) {
+      int n = bytes > (size_t(1) << 20) ? std::max(1, repeat / 100) : repeat;
+      results.push_back(measure("memcpy", "host to device", bytes, n, [&]() {
+        q.memcpy(dev, host, bytes).wait();
+      }));
+      results.push_back(measure("memcpy", "device to host", bytes, n, [&]() {
+        q.memcpy(host, dev, bytes).wait();
+      }));
+    }
+    sycl::free(host, q);
+    sycl::free(dev, q);
+
+    std::cout << std::setw(12) << "benchmark" << std::setw(18) << "variant"
+              << std::setw(12) << "bytes" << std::setw(12) << "p50 us"
+              << std::setw(12) << "p99 us" << std::setw(12) << "mean us"
+              << std::setw(12) << "GB/s" << std::endl;
+    for (const Result& r : results) {
+      std::cout << std::setw(12) << r.benchmark << std::setw(18) << r.variant
+                << std::setw(12) << r.bytes << std::fixed << std::setprecision(2)
+                << std::setw(12) << r.p50_us << std::setw(12) << r.p99_us
+                << std::setw(12) << r.mean_us;
+      if (r.bytes) std::cout << std::setw(12) << r.bytes / (r.p50_us * 1e3);
+      std::cout << std::endl;
+    }
+    if (!csv_path.empty()) write_csv(csv_path, device_name, results);
+    if (!json_path.empty()) write_json(json_path, device_name, results);
+  } catch (sycl::exception const &e) {
+    // Catches exceptions in the host code.
+    std::cerr << "Caught a SYCL host exception:\n" << e.what() << "\n";
+
+    // Most likely the runtime couldn't find FPGA hardware!
+    if (e.code().value() == CL_DEVICE_NOT_FOUND) {
+      std::cerr << "If you are targeting an FPGA, please ensure that your "
+                   "system has a correctly configured FPGA board.\n";
+      std::cerr << "Run sys_check in the oneAPI root directory to verify.\n";
+      std::cerr << "If you are targeting the FPGA emulator, compile with "
+                   "-DFPGA_EMULATOR.\n";
+    }
+    std::terminate();
+  }
+
+  std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
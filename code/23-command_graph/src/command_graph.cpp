@@ -0,0 +1,204 @@
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+#include "replay.hpp"
+
+#define ALIGNMENT 64
+
+// Forward declare the kernel name in the global scope. This is an FPGA best
+// practice that reduces name mangling in the optimization reports.
+class ScaleID;
+
+// Parameters updated before every replay
+struct Params {
+  float scale;
+  float offset;
+};
+
+sycl::event scale_kernel(sycl::queue& q, const float* in, float* out,
+                         const Params* params, int n,
+                         const std::vector<sycl::event>& deps) {
+  return q.submit([&](sycl::handler& h) {
+    h.depends_on(deps);
+    h.single_task<ScaleID>([=]() [[intel::kernel_args_restrict]] {
+      const Params p = *params;
+      for (int i = 0; i < n; i++) out[i] = p.scale * in[i] + p.offset;
+    });
+  });
+}
+
+void usage(const char* exe) {
+  std::cout << "Usage: \n" << exe << " [--iterations N] [--size N] [--no-graph]"
+            << "\n\nFAILED\n";
+}
+
+int main(int argc, char* argv[]) {
+  int iterations = 1000;
+  int n = 2048;
+  bool use_graph = true;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--iterations") && i + 1 < argc) {
+      iterations = std::stoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--size") && i + 1 < argc) {
+      n = std::stoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--no-graph")) {
+      use_graph = false;
+    } else {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (iterations < 1 || n < 1) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  bool passed = true;
+  try {
+    // Use compile-time macros to select either:
+    //  - the FPGA emulator device (CPU emulation of the FPGA)
+    //  - the FPGA device (a real FPGA)
+    //  - the simulator device
+#if FPGA_SIMULATOR
+    auto selector = sycl::ext::intel::fpga_simulator_selector_v;
+#elif FPGA_HARDWARE
+    auto selector = sycl::ext::intel::fpga_selector_v;
+#else  // #if FPGA_EMULATOR
+    auto selector = sycl::ext::intel::fpga_emulator_selector_v;
+#endif
+
+    sycl::queue q(selector);
+
+    auto device = q.get_device();
+    std::cout << "Running on device: "
+              << device.get_info<sycl::info::device::name>().c_str()
+              << std::endl;
+
+    // host USM staging areas: the recorded commands copy from and to them
+    const size_t bytes = n * sizeof(float);
+    float* host_in = sycl::malloc_host<float>(n, q);
+    float* host_out = sycl::malloc_host<float>(n, q);
+    Params* host_params = sycl::malloc_host<Params>(1, q);
+    float* in = static_cast<float*>(sycl::aligned_alloc_device(ALIGNMENT, bytes, q));
+    float* out = static_cast<float*>(sycl::aligned_alloc_device(ALIGNMENT, bytes, q));
+    Params* params = sycl::malloc_device<Params>(1, q);
+
+    // new input and parameters for iteration it
+    auto update = [&](int it) {
+      host_params->scale = float(it % 10 + 1);
+      host_params->offset = float(it % 3);
+      host_in[it % n] = float(it);
+    };
+    auto verify = [&](const char* name) {
+      for (int i = 0; i < n; i++) {
+        float expected = host_params->scale * host_in[i] + host_params->offset;
+        if (host_out[i] != expected) {
+          std::cout << name << ": element " << i << " = " << host_out[i]
+                    << ", expected " << expected << std::endl;
+          return false;
+        }
+      }
+      return true;
+    };
+    auto report = [&](const char* name, double seconds) {
+      std::cout << std::setw(28) << name << ": " << std::fixed
+                << std::setprecision(3) << seconds * 1e6 / iterations
+                << " us per iteration" << std::endl;
+    };
+    using Clock = std::chrono::steady_clock;
+
+    std::cout << iterations << " iterations of memcpy -> kernel -> memcpy on "
+              << n << " floats" << std::endl;
+
+    // the sequence submitted by hand at every iteration
+    for (int i = 0; i < n; i++) host_in[i] = float(i);
+    auto start = Clock::now();
+    for (int it = 0; it < iterations; it++) {
+      update(it);
+      sycl::event p = q.memcpy(params, host_params, sizeof(Params));
+      sycl::event c = q.memcpy(in, host_in, bytes, p);
+      sycl::event k = scale_kernel(q, in, out, params, n, {c});
+      q.memcpy(host_out, out, bytes, k).wait();
+    }
+    report("plain submits", std::chrono::duration<double>(Clock::now() - start).count());
+    passed &= verify("plain submits");
+
+    // the same sequence, recorded once
+    auto record = [&](ReplaySequence& sequence) {
+      sequence.record([=](sycl::queue& q, const std::vector<sycl::event>& deps) {
+        return q.memcpy(params, host_params, sizeof(Params), deps);
+      });
+      sequence.record([=](sycl::queue& q, const std::vector<sycl::event>& deps) {
+        return q.memcpy(in, host_in, bytes, deps);
+      });
+      sequence.record([=](sycl::queue& q, const std::vector<sycl::event>& deps) {
+        return scale_kernel(q, in, out, params, n, deps);
+      });
+      sequence.record([=](sycl::queue& q, const std::vector<sycl::event>& deps) {
+        return q.memcpy(host_out, out, bytes, deps);
+      });
+    };
+
+    auto replay = [&](ReplaySequence& sequence, const char* name) {
+      for (int i = 0; i < n; i++) host_in[i] = float(i);
+      auto start = Clock::now();
+      for (int it = 0; it < iterations; it++) {
+        update(it);
+        sequence.replay().wait();
+      }
+      report(name, std::chrono::duration<double>(Clock::now() - start).count());
+      passed &= verify(name);
+    };
+
+    ReplaySequence submits(q);
+    record(submits);
+    submits.finalize(false);
+    replay(submits, "replay, plain submits");
+
+    if (use_graph) {
+      ReplaySequence graph(q);
+      record(graph);
+      start = Clock::now();
+      bool finalized = graph.finalize(true);
+      double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+      if (finalized) {
+        std::cout << "Graph recorded and finalized in " << seconds * 1e6
+                  << " us" << std::endl;
+        replay(graph, "replay, command graph");
+      } else {
+        std::cout << "Falling back to plain submits" << std::endl;
+      }
+    }
+
+    sycl::free(host_in, q);
+    sycl::free(host_out, q);
+    sycl::free(host_params, q);
+    sycl::free(in, q);
+    sycl::free(out, q);
+    sycl::free(params, q);
+  } catch (sycl::exception const &e) {
+    // Catches exceptions in the host code.
+    std::cerr << "Caught a SYCL host exception:\n" << e.what() << "\n";
+
+    // Most likely the runtime couldn't find FPGA hardware!
+    if (e.code().value() == CL_DEVICE_NOT_FOUND) {
+      std::cerr << "If you are targeting an FPGA, please ensure that your "
+                   "system has a correctly configured FPGA board.\n";
+      std::cerr << "Run sys_check in the oneAPI root directory to verify.\n";
+      std::cerr << "If you are targeting the FPGA emulator, compile with "
+                   "-DFPGA_EMULATOR.\n";
+    }
+    std::terminate();
+  }
+
+  std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,126 @@
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <vector>
+
+// oneAPI headers
+#include <sycl/sycl.hpp>
+
+////////////////////////////////////////////////////////////////////////
+//
+// Record once, replay many times.
+//
+// A sequence of commands (memcpy, kernels, ...) is recorded once as
+// functions that submit one command after the given dependencies. It is
+// then replayed as:
+//  - a command graph (sycl_ext_oneapi_graph) when the compiler provides
+//    it and the device supports it: the whole sequence is a single
+//    submission, with the dependencies resolved at finalize time;
+//  - otherwise plain submits of the recorded functions, chained by their
+//    events.
+//
+// The commands capture pointers, not values, so parameters are updated
+// between replays by writing the memory they point to (e.g. a parameter
+// block in host USM that the sequence copies to the device).
+//
+////////////////////////////////////////////////////////////////////////
+using Command = std::function<sycl::event(sycl::queue&, const std::vector<sycl::event>&)>;
+
+#ifdef SYCL_EXT_ONEAPI_GRAPH
+namespace graph_ext = sycl::ext::oneapi::experimental;
+#endif
+
+class ReplaySequence {
+ public:
+  explicit ReplaySequence(sycl::queue& q) : q_(q) {}
+
+  void record(Command c) { commands_.push_back(std::move(c)); }
+
+  // Build the command graph if requested and supported, returns whether
+  // the replays go through a graph
+  bool finalize(bool use_graph) {
+#ifdef SYCL_EXT_ONEAPI_GRAPH
+    if (use_graph) {
+      if (!q_.get_device().has(sycl::aspect::ext_oneapi_graph)) {
+        std::cout << "Command graphs are not supported by the device" << std::endl;
+        return false;
+      }
+      try {
+        graph_ext::command_graph graph{q_.get_context(), q_.get_device()};
+        {
+          Recording recording(graph, q_);
+          submit_all();
+        }
+        executable_.emplace(graph.finalize());
+        return true;
+      } catch (sycl::exception const& e) {
+        std::cout << "Command graph unavailable: " << e.what() << std::endl;
+        executable_.reset();
+        return false;
+      }
+    }
+#else
+    if (use_graph)
+      std::cout << "Command graphs are not provided by this compiler" << std::endl;
+#endif
+    return false;
+  }
+
+  bool uses_graph() const {
+#ifdef SYCL_EXT_ONEAPI_GRAPH
+    return executable_.has_value();
+#else
+    return false;
+#endif
+  }
+
+  sycl::event replay() {
+#ifdef SYCL_EXT_ONEAPI_GRAPH
+    if (executable_) return q_.ext_oneapi_graph(*executable_);
+#endif
+    return submit_all();
+  }
+
+ private:
+  sycl::event submit_all() {
+    sycl::event last;
+    for (size_t i = 0; i < commands_.size(); i++)
+      last = (i == 0) ? commands_[i](q_, {}) : commands_[i](q_, {last});
+    return last;
+  }
+
+#ifdef SYCL_EXT_ONEAPI_GRAPH
+  // Records the submissions of q into graph during its lifetime. The
+  // recording also ends when a submission throws, so that the fallback
+  // to plain submits executes on q instead of recording into the graph.
+  class Recording {
+   public:
+    Recording(graph_ext::command_graph<graph_ext::graph_state::modifiable>& graph,
+              sycl::queue& q)
+        : graph_(graph) {
+      graph_.begin_recording(q);
+    }
+    ~Recording() {
+      try {
+        graph_.end_recording();
+      } catch (sycl::exception const& e) {
+        std::cout << "Could not end the graph recording: " << e.what() << std::endl;
+      }
+    }
+
+   private:
+    graph_ext::command_graph<graph_ext::graph_state::modifiable>& graph_;
+  };
+#endif
+
+  sycl::queue& q_;
+  std::vector<Command> commands_;
+#ifdef SYCL_EXT_ONEAPI_GRAPH
+  std::optional<graph_ext::command_graph<graph_ext::graph_state::executable>> executable_;
+#endif
+};
+
+#endif
@@ -0,0 +1,229 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+#include "async_tasks.hpp"
+
+#define ALIGNMENT 64
+
+// Forward declare the kernel names in the global scope. This is an FPGA best
+// practice that reduces name mangling in the optimization reports.
+class VectorAddBufferID;
+class VectorAddUsmID;
+
+// Number of batches in flight in the asynchronous pipeline
+constexpr int kSlots = 2;
+
+void VectorAdd(const int *vec_a_in, const int *vec_b_in, int *vec_c_out,
+               int len) {
+  for (int idx = 0; idx < len; idx++) {
+    int a_val = vec_a_in[idx];
+    int b_val = vec_b_in[idx];
+    int sum = a_val + b_val;
+    vec_c_out[idx] = sum;
+  }
+}
+
+// Host work done for every batch: generate the inputs ...
+void prepare(int batch, int* vec_a, int* vec_b, int len) {
+  for (int i = 0; i < len; i++) {
+    vec_a[i] = (batch * 7919 + i * 31) % 1000;
+    vec_b[i] = (i * 17 - batch) % 1000;
+  }
+}
+
+// ... and check the result
+bool check(int batch, const int* vec_c, int len) {
+  for (int i = 0; i < len; i++) {
+    int expected = (batch * 7919 + i * 31) % 1000 + (i * 17 - batch) % 1000;
+    if (vec_c[i] != expected) {
+      std::cout << "batch " << batch << " idx=" << i << ": result " << vec_c[i]
+                << ", expected " << expected << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+void usage(const char* exe) {
+  std::cout << "Usage: \n" << exe << " [--batches N] [--size N]"
+            << "\n\nFAILED\n";
+}
+
+int main(int argc, char* argv[]) {
+  int batches = 64;
+  int len = 1 << 16;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--batches") && i + 1 < argc) {
+      batches = std::stoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--size") && i + 1 < argc) {
+      len = std::stoi(argv[++i]);
+    } else {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (batches < 1 || len < 1) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  bool passed = true;
+  try {
+    // Use compile-time macros to select either:
+    //  - the FPGA emulator device (CPU emulation of the FPGA)
+    //  - the FPGA device (a real FPGA)
+    //  - the simulator device
+#if FPGA_SIMULATOR
+    auto selector = sycl::ext::intel::fpga_simulator_selector_v;
+#elif FPGA_HARDWARE
+    auto selector = sycl::ext::intel::fpga_selector_v;
+#else  // #if FPGA_EMULATOR
+    auto selector = sycl::ext::intel::fpga_emulator_selector_v;
+#endif
+
+    sycl::queue q(selector);
+
+    auto device = q.get_device();
+    std::cout << "Running on device: "
+              << device.get_info<sycl::info::device::name>().c_str()
+              << std::endl;
+
+    using Clock = std::chrono::steady_clock;
+    auto seconds_since = [](Clock::time_point start) {
+      return std::chrono::duration<double>(Clock::now() - start).count();
+    };
+    std::cout << batches << " batches of vector add on " << len << " ints"
+              << std::endl;
+
+    // 1. blocking: the buffers are destroyed at the end of each scope,
+    // which waits for the kernel and the copy back before the host moves on
+    int * vec_a = new(std::align_val_t{ ALIGNMENT }) int[len];
+    int * vec_b = new(std::align_val_t{ ALIGNMENT }) int[len];
+    int * vec_c = new(std::align_val_t{ ALIGNMENT }) int[len];
+    double host_seconds = 0.0;
+    auto start = Clock::now();
+    for (int batch = 0; batch < batches; batch++) {
+      auto host_start = Clock::now();
+      prepare(batch, vec_a, vec_b, len);
+      host_seconds += seconds_since(host_start);
+      {
+        sycl::buffer buffer_a{vec_a, sycl::range(len)};
+        sycl::buffer buffer_b{vec_b, sycl::range(len)};
+        sycl::buffer buffer_c{vec_c, sycl::range(len)};
+
+        q.submit([&](sycl::handler &h) {
+          sycl::accessor accessor_a{buffer_a, h, sycl::read_only};
+          sycl::accessor accessor_b{buffer_b, h, sycl::read_only};
+          sycl::accessor accessor_c{buffer_c, h, sycl::write_only, sycl::no_init};
+
+          h.single_task<VectorAddBufferID>([=]() {
+            VectorAdd(&accessor_a[0], &accessor_b[0], &accessor_c[0], len);
+          });
+        });
+      }
+      host_start = Clock::now();
+      passed &= check(batch, vec_c, len);
+      host_seconds += seconds_since(host_start);
+    }
+    double blocking_seconds = seconds_since(start);
+    delete[] vec_a;
+    delete[] vec_b;
+    delete[] vec_c;
+
+    // 2. asynchronous: kSlots batches in flight, the host prepares the
+    // next batch and checks an older one while the device works
+    int* host_a[kSlots];
+    int* host_b[kSlots];
+    int* host_c[kSlots];
+    int* dev_a[kSlots];
+    int* dev_b[kSlots];
+    int* dev_c[kSlots];
+    const size_t bytes = len * sizeof(int);
+    for (int s = 0; s < kSlots; s++) {
+      host_a[s] = sycl::malloc_host<int>(len, q);
+      host_b[s] = sycl::malloc_host<int>(len, q);
+      host_c[s] = sycl::malloc_host<int>(len, q);
+      dev_a[s] = static_cast<int*>(sycl::aligned_alloc_device(ALIGNMENT, bytes, q));
+      dev_b[s] = static_cast<int*>(sycl::aligned_alloc_device(ALIGNMENT, bytes, q));
+      dev_c[s] = static_cast<int*>(sycl::aligned_alloc_device(ALIGNMENT, bytes, q));
+    }
+
+    Task pending[kSlots];
+    start = Clock::now();
+    for (int batch = 0; batch < batches + kSlots; batch++) {
+      const int s = batch % kSlots;
+      // the slot is free once the batch that used it has completed
+      if (batch >= kSlots) {
+        pending[s].wait();
+        passed &= check(batch - kSlots, host_c[s], len);
+      }
+      if (batch >= batches) continue;
+
+      prepare(batch, host_a[s], host_b[s], len);
+      const int* a = dev_a[s];
+      const int* b = dev_b[s];
+      int* c = dev_c[s];
+      pending[s] = when_all({async_memcpy(q, dev_a[s], host_a[s], bytes),
+                             async_memcpy(q, dev_b[s], host_b[s], bytes)})
+                       .then([=](sycl::handler& h) {
+                         h.single_task<VectorAddUsmID>(
+                             [=]() [[intel::kernel_args_restrict]] {
+                               VectorAdd(a, b, c, len);
+                             });
+                       })
+                       .then_memcpy(host_c[s], dev_c[s], bytes);
+    }
+    double async_seconds = seconds_since(start);
+
+    for (int s = 0; s < kSlots; s++) {
+      sycl::free(host_a[s], q);
+      sycl::free(host_b[s], q);
+      sycl::free(host_c[s], q);
+      sycl::free(dev_a[s], q);
+      sycl::free(dev_b[s], q);
+      sycl::free(dev_c[s], q);
+    }
+
+    // the device time is what remains of the blocking run without the
+    // host work; perfect overlap hides the shorter of the two
+    double device_seconds = blocking_seconds - host_seconds;
+    double hideable = std::min(host_seconds, device_seconds);
+    double hidden = blocking_seconds - async_seconds;
+    std::cout << std::fixed << std::setprecision(3)
+              << std::setw(24) << "host work: " << host_seconds * 1e3 << " ms\n"
+              << std::setw(24) << "blocking (buffers): " << blocking_seconds * 1e3
+              << " ms\n"
+              << std::setw(24) << "async tasks: " << async_seconds * 1e3
+              << " ms\n"
+              << std::setw(24) << "speedup: " << blocking_seconds / async_seconds
+              << "x\n";
+    if (hideable > 0.0)
+      std::cout << std::setw(24) << "overlap: " << std::setprecision(1)
+                << std::max(0.0, 100.0 * hidden / hideable)
+                << " % of the shorter side hidden\n";
+  } catch (sycl::exception const &e) {
+    // Catches exceptions in the host code.
+    std::cerr << "Caught a SYCL host exception:\n" << e.what() << "\n";
+
+    // Most likely the runtime couldn't find FPGA hardware!
+    if (e.code().value() == CL_DEVICE_NOT_FOUND) {
+      std::cerr << "If you are targeting an FPGA, please ensure that your "
+                   "system has a correctly configured FPGA board.\n";
+      std::cerr << "Run sys_check in the oneAPI root directory to verify.\n";
+      std::cerr << "If you are targeting the FPGA emulator, compile with "
+                   "-DFPGA_EMULATOR.\n";
+    }
+    std::terminate();
+  }
+
+  std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
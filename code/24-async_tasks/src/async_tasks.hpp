@@ -0,0 +1,94 @@
+#ifndef ASYNC_TASKS_HPP
+#define ASYNC_TASKS_HPP
+
+#include <utility>
+#include <vector>
+
+// oneAPI headers
+#include <sycl/sycl.hpp>
+
+////////////////////////////////////////////////////////////////////////
+//
+// Future-like handles on submitted commands.
+//
+// A Task is the set of events a later command has to wait for. Nothing
+// blocks the host until wait() is called:
+//  - async(q, cgf)            submits a command group with no dependency
+//  - async_memcpy(q, d, s, n) submits a copy with no dependency
+//  - t.then(cgf)              submits a command group after t
+//  - t.then_memcpy(d, s, n)   submits a copy after t
+//  - when_all({t1, t2, ...})  completes when all the tasks complete, it
+//                             only merges the events, nothing is submitted
+//
+// Dependencies are mapped on handler::depends_on and on the event list
+// of queue::memcpy, so the queue may be out-of-order.
+//
+////////////////////////////////////////////////////////////////////////
+class Task {
+ public:
+  Task() = default;
+  Task(sycl::queue& q, std::vector<sycl::event> events)
+      : q_(&q), events_(std::move(events)) {}
+
+  // Submit the command group cgf(handler&) after this task
+  template <typename CGF>
+  Task then(CGF&& cgf) const {
+    sycl::event e = queue().submit([&](sycl::handler& h) {
+      h.depends_on(events_);
+      cgf(h);
+    });
+    return Task(*q_, {e});
+  }
+
+  Task then_memcpy(void* dst, const void* src, size_t bytes) const {
+    return Task(queue(), {q_->memcpy(dst, src, bytes, events_)});
+  }
+
+  bool ready() const {
+    for (const sycl::event& e : events_)
+      if (e.get_info<sycl::info::event::command_execution_status>() !=
+          sycl::info::event_command_status::complete)
+        return false;
+    return true;
+  }
+
+  void wait() {
+    sycl::event::wait(events_);
+    events_.clear();
+  }
+
+  // A default-constructed task has no queue to submit to
+  sycl::queue& queue() const {
+    if (!q_)
+      throw sycl::exception(sycl::make_error_code(sycl::errc::invalid),
+                            "Task: no queue");
+    return *q_;
+  }
+  const std::vector<sycl::event>& events() const { return events_; }
+
+ private:
+  sycl::queue* q_ = nullptr;
+  std::vector<sycl::event> events_;
+};
+
+template <typename CGF>
+Task async(sycl::queue& q, CGF&& cgf) {
+  return Task(q, {}).then(std::forward<CGF>(cgf));
+}
+
+inline Task async_memcpy(sycl::queue& q, void* dst, const void* src, size_t bytes) {
+  return Task(q, {}).then_memcpy(dst, src, bytes);
+}
+
+// All the tasks must come from the same queue, and there must be at least one
+inline Task when_all(const std::vector<Task>& tasks) {
+  if (tasks.empty())
+    throw sycl::exception(sycl::make_error_code(sycl::errc::invalid),
+                          "when_all: no task");
+  std::vector<sycl::event> events;
+  for (const Task& t : tasks)
+    events.insert(events.end(), t.events().begin(), t.events().end());
+  return Task(tasks.front().queue(), std::move(events));
+}
+
+#endif
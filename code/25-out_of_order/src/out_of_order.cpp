@@ -0,0 +1,289 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+#define ALIGNMENT 64
+
+////////////////////////////////////////////////////////////////////////
+//
+// Independent kernels on an out-of-order queue.
+//
+// kKernels vector adds on separate slices, then kKernels matmult kernels
+// on separate row blocks of C. Each kernel has its own name, hence its
+// own compute unit in the bitstream, and only depends (handler::depends_on)
+// on the copies of its inputs; the copy back depends on all of them.
+//
+// The same submissions go to an in-order queue, where every command waits
+// for the previous one, and to an out-of-order queue, where the runtime
+// is free to run the independent kernels concurrently. The makespan is
+// the span of the profiling timestamps from the first copy to the last.
+//
+////////////////////////////////////////////////////////////////////////
+constexpr int kKernels = 4;
+constexpr int kTile = 16;
+
+// Forward declare the kernel names in the global scope. This is an FPGA best
+// practice that reduces name mangling in the optimization reports.
+template <int k> class VecAddID;
+template <int k> class MatMultBlockID;
+
+// Call f(std::integral_constant<int, k>) for k in [0, kKernels)
+template <typename F, int... ks>
+std::vector<sycl::event> for_each_kernel(F f, std::integer_sequence<int, ks...>) {
+  return {f(std::integral_constant<int, ks>{})...};
+}
+
+template <int k>
+sycl::event vector_add(sycl::queue& q, const std::vector<sycl::event>& deps,
+                       const int* a, const int* b, int* c, int len) {
+  return q.submit([&](sycl::handler& h) {
+    h.depends_on(deps);
+    h.single_task<VecAddID<k>>([=]() [[intel::kernel_args_restrict]] {
+      for (int i = 0; i < len; i++) c[i] = a[i] + b[i];
+    });
+  });
+}
+
+// Rows [k * n / kKernels, (k + 1) * n / kKernels) of C = A x B, tiled in
+// local memory as in 04-matmult_ndrange
+template <int k>
+sycl::event matmult_block(sycl::queue& q, const std::vector<sycl::event>& deps,
+                          const float* a, const float* b, float* c, int n) {
+  const int rows = n / kKernels;
+  const int row0 = k * rows;
+  return q.submit([&](sycl::handler& h) {
+    h.depends_on(deps);
+    sycl::local_accessor<float, 2> tileA{{kTile, kTile}, h};
+    sycl::local_accessor<float, 2> tileB{{kTile, kTile}, h};
+    sycl::range<2> global(rows, n);
+    sycl::range<2> local(kTile, kTile);
+    h.parallel_for<MatMultBlockID<k>>(sycl::nd_range<2>{global, local},
+        [=](sycl::nd_item<2> item)
+            [[intel::max_work_group_size(1, kTile, kTile)]] {
+      int m = row0 + item.get_global_id()[0];
+      int col = item.get_global_id()[1];
+      int i = item.get_local_id()[0];
+      int j = item.get_local_id()[1];
+
+      float sum = 0;
+      for (int p = 0; p < n / kTile; p++) {
+        tileA[i][j] = a[m * n + p * kTile + j];
+        tileB[i][j] = b[(p * kTile + i) * n + col];
+        sycl::group_barrier(item.get_group());
+        for (int kk = 0; kk < kTile; kk++) sum += tileA[i][kk] * tileB[kk][j];
+        sycl::group_barrier(item.get_group());
+      }
+      c[m * n + col] = sum;
+    });
+  });
+}
+
+// Span in ms of the profiling timestamps of the events
+double span_time(const std::vector<sycl::event>& events) {
+  double start = 0.0, end = 0.0;
+  for (size_t i = 0; i < events.size(); i++) {
+    double s = events[i].get_profiling_info<sycl::info::event_profiling::command_start>();
+    double e = events[i].get_profiling_info<sycl::info::event_profiling::command_end>();
+    start = (i == 0) ? s : std::min(start, s);
+    end = (i == 0) ? e : std::max(end, e);
+  }
+  return (end - start) * 1e-6;
+}
+
+// Sum in ms of the kernel times of the events
+double busy_time(const std::vector<sycl::event>& events) {
+  double sum = 0.0;
+  for (const sycl::event& e : events)
+    sum += (e.get_profiling_info<sycl::info::event_profiling::command_end>() -
+            e.get_profiling_info<sycl::info::event_profiling::command_start>()) * 1e-6;
+  return sum;
+}
+
+void usage(const char* exe) {
+  std::cout << "Usage: \n" << exe << " [--size N] [--n N]"
+            << "\n\nFAILED\n";
+}
+
+int main(int argc, char* argv[]) {
+  int len = 1 << 20;
+  int n = 256;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--size") && i + 1 < argc) {
+      len = std::stoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--n") && i + 1 < argc) {
+      n = std::stoi(argv[++i]);
+    } else {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  // every kernel gets a slice of the vectors and whole tiles of C
+  if (len < kKernels || len % kKernels || n < 1 || n % (kKernels * kTile)) {
+    std::cout << "--size must be a multiple of " << kKernels
+              << " and --n a multiple of " << kKernels * kTile << std::endl;
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  bool passed = true;
+  try {
+    // Use compile-time macros to select either:
+    //  - the FPGA emulator device (CPU emulation of the FPGA)
+    //  - the FPGA device (a real FPGA)
+    //  - the simulator device
+#if FPGA_SIMULATOR
+    auto selector = sycl::ext::intel::fpga_simulator_selector_v;
+#elif FPGA_HARDWARE
+    auto selector = sycl::ext::intel::fpga_selector_v;
+#else  // #if FPGA_EMULATOR
+    auto selector = sycl::ext::intel::fpga_emulator_selector_v;
+#endif
+
+    sycl::queue ooo(selector, sycl::property::queue::enable_profiling{});
+    sycl::queue in_order(ooo.get_context(), ooo.get_device(),
+                         sycl::property_list{sycl::property::queue::in_order{},
+                                             sycl::property::queue::enable_profiling{}});
+
+    auto device = ooo.get_device();
+    std::cout << "Running on device: "
+              << device.get_info<sycl::info::device::name>().c_str()
+              << std::endl;
+
+    const auto kernels = std::make_integer_sequence<int, kKernels>{};
+    const int slice = len / kKernels;
+
+    // vector inputs and outputs
+    std::vector<int> host_a(len), host_b(len), host_c(len);
+    for (int i = 0; i < len; i++) {
+      host_a[i] = i;
+      host_b[i] = len - i;
+    }
+    const size_t vec_bytes = len * sizeof(int);
+    int* vec_a = static_cast<int*>(sycl::aligned_alloc_device(ALIGNMENT, vec_bytes, ooo));
+    int* vec_b = static_cast<int*>(sycl::aligned_alloc_device(ALIGNMENT, vec_bytes, ooo));
+    int* vec_c = static_cast<int*>(sycl::aligned_alloc_device(ALIGNMENT, vec_bytes, ooo));
+
+    // matrix inputs and outputs
+    std::vector<float> mat_a(n * n), mat_b(n * n), mat_c(n * n);
+    for (int i = 0; i < n * n; i++) {
+      mat_a[i] = (i % 17) * 0.125f;
+      mat_b[i] = (i % 13) * 0.25f - 1.0f;
+    }
+    const size_t mat_bytes = n * n * sizeof(float);
+    float* dev_a = static_cast<float*>(sycl::aligned_alloc_device(ALIGNMENT, mat_bytes, ooo));
+    float* dev_b = static_cast<float*>(sycl::aligned_alloc_device(ALIGNMENT, mat_bytes, ooo));
+    float* dev_c = static_cast<float*>(sycl::aligned_alloc_device(ALIGNMENT, mat_bytes, ooo));
+
+    std::vector<float> expected(n * n, 0.0f);
+    for (int i = 0; i < n; i++)
+      for (int k = 0; k < n; k++)
+        for (int j = 0; j < n; j++) expected[i * n + j] += mat_a[i * n + k] * mat_b[k * n + j];
+
+    // The same submissions on both queues
+    auto run = [&](sycl::queue& q, const char* name) {
+      std::fill(host_c.begin(), host_c.end(), 0);
+      std::fill(mat_c.begin(), mat_c.end(), 0.0f);
+      auto start = std::chrono::steady_clock::now();
+
+      std::vector<sycl::event> copies = {
+          q.memcpy(vec_a, host_a.data(), vec_bytes),
+          q.memcpy(vec_b, host_b.data(), vec_bytes),
+          q.memcpy(dev_a, mat_a.data(), mat_bytes),
+          q.memcpy(dev_b, mat_b.data(), mat_bytes)};
+      std::vector<sycl::event> vec_deps = {copies[0], copies[1]};
+      std::vector<sycl::event> mat_deps = {copies[2], copies[3]};
+
+      std::vector<sycl::event> adds = for_each_kernel([&](auto k) {
+        const size_t offset = size_t(k.value) * slice;
+        return vector_add<k.value>(q, vec_deps, vec_a + offset, vec_b + offset,
+                                   vec_c + offset, slice);
+      }, kernels);
+      std::vector<sycl::event> blocks = for_each_kernel([&](auto k) {
+        return matmult_block<k.value>(q, mat_deps, dev_a, dev_b, dev_c, n);
+      }, kernels);
+
+      std::vector<sycl::event> all = copies;
+      all.insert(all.end(), adds.begin(), adds.end());
+      all.insert(all.end(), blocks.begin(), blocks.end());
+      sycl::event out_vec = q.memcpy(host_c.data(), vec_c, vec_bytes, adds);
+      sycl::event out_mat = q.memcpy(mat_c.data(), dev_c, mat_bytes, blocks);
+      out_vec.wait();
+      out_mat.wait();
+      double wall = std::chrono::duration<double, std::milli>(
+          std::chrono::steady_clock::now() - start).count();
+      all.push_back(out_vec);
+      all.push_back(out_mat);
+
+      std::vector<sycl::event> kernel_events = adds;
+      kernel_events.insert(kernel_events.end(), blocks.begin(), blocks.end());
+      double makespan = span_time(all);
+      double busy = busy_time(kernel_events);
+      std::cout << std::setw(14) << name << std::fixed << std::setprecision(3)
+                << std::setw(14) << makespan << std::setw(14) << span_time(kernel_events)
+                << std::setw(14) << busy << std::setw(14) << wall << std::endl;
+
+      for (int i = 0; i < len; i++)
+        if (host_c[i] != host_a[i] + host_b[i]) {
+          std::cout << name << ": c[" << i << "] = " << host_c[i] << ", expected "
+                    << host_a[i] + host_b[i] << std::endl;
+          passed = false;
+          break;
+        }
+      for (int i = 0; i < n * n; i++)
+        if (std::fabs(mat_c[i] - expected[i]) > 1e-4f * std::max(1.0f, std::fabs(expected[i]))) {
+          std::cout << name << ": C[" << i / n << ";" << i % n << "] = " << mat_c[i]
+                    << ", expected " << expected[i] << std::endl;
+          passed = false;
+          break;
+        }
+      return makespan;
+    };
+
+    std::cout << kKernels << " vector adds of " << slice << " ints and "
+              << kKernels << " matmult blocks of " << n / kKernels << "x" << n
+              << std::endl;
+    std::cout << std::setw(14) << "queue" << std::setw(14) << "makespan ms"
+              << std::setw(14) << "kernels ms" << std::setw(14) << "busy ms"
+              << std::setw(14) << "host ms" << std::endl;
+    // untimed run for the first-launch costs
+    run(in_order, "warm-up");
+    double serial = run(in_order, "in-order");
+    double concurrent = run(ooo, "out-of-order");
+    if (concurrent > 0.0)
+      std::cout << "out-of-order speedup on the makespan: " << std::setprecision(2)
+                << serial / concurrent << "x" << std::endl;
+
+    sycl::free(vec_a, ooo);
+    sycl::free(vec_b, ooo);
+    sycl::free(vec_c, ooo);
+    sycl::free(dev_a, ooo);
+    sycl::free(dev_b, ooo);
+    sycl::free(dev_c, ooo);
+  } catch (sycl::exception const &e) {
+    // Catches exceptions in the host code.
+    std::cerr << "Caught a SYCL host exception:\n" << e.what() << "\n";
+
+    // Most likely the runtime couldn't find FPGA hardware!
+    if (e.code().value() == CL_DEVICE_NOT_FOUND) {
+      std::cerr << "If you are targeting an FPGA, please ensure that your "
+                   "system has a correctly configured FPGA board.\n";
+      std::cerr << "Run sys_check in the oneAPI root directory to verify.\n";
+      std::cerr << "If you are targeting the FPGA emulator, compile with "
+                   "-DFPGA_EMULATOR.\n";
+    }
+    std::terminate();
+  }
+
+  std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+#include "compute_units.hpp"
+
+#define ALIGNMENT 64
+
+// Forward declare the kernel names in the global scope. This is an FPGA best
+// practice that reduces name mangling in the optimization reports.
+template <int copies, int id> class VectorAddCUID;
+
+// Span in ms of the profiling timestamps of the events
+double span_time(const std::vector<sycl::event>& events) {
+  double start = 0.0, end = 0.0;
+  for (size_t i = 0; i < events.size(); i++) {
+    double s = events[i].get_profiling_info<sycl::info::event_profiling::command_start>();
+    double e = events[i].get_profiling_info<sycl::info::event_profiling::command_end>();
+    start = (i == 0) ? s : std::min(start, s);
+    end = (i == 0) ? e : std::max(end, e);
+  }
+  return (end - start) * 1e-6;
+}
+
+// c = a + b on kCopies compute units, each on its own slice
+template <int kCopies>
+std::vector<sycl::event> vector_add(sycl::queue& q, const int* a, const int* b,
+                                    int* c, int len) {
+  return SubmitComputeUnits<kCopies, VectorAddCUID>(q, [=](auto id) {
+    auto [begin, end] = Partition(id, kCopies, len);
+    [[intel::initiation_interval(1)]]
+    for (int i = begin; i < end; i++) c[i] = a[i] + b[i];
+  });
+}
+
+void usage(const char* exe) {
+  std::cout << "Usage: \n" << exe << " [--size N]\n\nFAILED\n";
+}
+
+int main(int argc, char* argv[]) {
+  int len = 1 << 24;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--size") && i + 1 < argc) {
+      len = std::stoi(argv[++i]);
+    } else {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (len < 1) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  bool passed = true;
+  try {
+    // Use compile-time macros to select either:
+    //  - the FPGA emulator device (CPU emulation of the FPGA)
+    //  - the FPGA device (a real FPGA)
+    //  - the simulator device
+#if FPGA_SIMULATOR
+    auto selector = sycl::ext::intel::fpga_simulator_selector_v;
+#elif FPGA_HARDWARE
+    auto selector = sycl::ext::intel::fpga_selector_v;
+#else  // #if FPGA_EMULATOR
+    auto selector = sycl::ext::intel::fpga_emulator_selector_v;
+#endif
+
+    sycl::queue q(selector, sycl::property::queue::enable_profiling{});
+
+    auto device = q.get_device();
+    std::cout << "Running on device: "
+              << device.get_info<sycl::info::device::name>().c_str()
+              << std::endl;
+
+    int* host_a = new (std::align_val_t{ ALIGNMENT }) int[len];
+    int* host_b = new (std::align_val_t{ ALIGNMENT }) int[len];
+    int* host_c = new (std::align_val_t{ ALIGNMENT }) int[len];
+    for (int i = 0; i < len; i++) {
+      host_a[i] = i;
+      host_b[i] = len - 2 * i;
+    }
+    const size_t bytes = len * sizeof(int);
+    int* a = static_cast<int*>(sycl::aligned_alloc_device(ALIGNMENT, bytes, q));
+    int* b = static_cast<int*>(sycl::aligned_alloc_device(ALIGNMENT, bytes, q));
+    int* c = static_cast<int*>(sycl::aligned_alloc_device(ALIGNMENT, bytes, q));
+    q.memcpy(a, host_a, bytes).wait();
+    q.memcpy(b, host_b, bytes).wait();
+
+    // bandwidth ceiling: device to device copy, reading and writing once
+    double copy_ms = span_time({q.memcpy(c, a, bytes)});
+    q.wait();
+    double copy_gbs = copy_ms > 0.0 ? 2.0 * bytes / (copy_ms * 1e6) : 0.0;
+    std::cout << "vector add on " << len << " ints, device copy at "
+              << std::fixed << std::setprecision(2) << copy_gbs << " GB/s"
+              << std::endl;
+
+    std::cout << std::setw(8) << "CUs" << std::setw(12) << "ms"
+              << std::setw(12) << "GB/s" << std::setw(12) << "speedup"
+              << std::setw(12) << "% of copy" << std::endl;
+    double base_ms = 0.0;
+    auto run = [&](int copies, std::vector<sycl::event> events) {
+      q.wait();
+      double ms = span_time(events);
+      if (copies == 1) base_ms = ms;
+      double gbs = ms > 0.0 ? 3.0 * bytes / (ms * 1e6) : 0.0;
+      std::cout << std::setw(8) << copies << std::fixed << std::setprecision(3)
+                << std::setw(12) << ms << std::setprecision(2)
+                << std::setw(12) << gbs << std::setw(12)
+                << (ms > 0.0 ? base_ms / ms : 0.0) << std::setw(12)
+                << (copy_gbs > 0.0 ? 100.0 * gbs / copy_gbs : 0.0) << std::endl;
+
+      q.memcpy(host_c, c, bytes).wait();
+      for (int i = 0; i < len; i++)
+        if (host_c[i] != host_a[i] + host_b[i]) {
+          std::cout << copies << " CUs: c[" << i << "] = " << host_c[i]
+                    << ", expected " << host_a[i] + host_b[i] << std::endl;
+          passed = false;
+          break;
+        }
+      q.memset(c, 0, bytes).wait();
+    };
+    run(1, vector_add<1>(q, a, b, c, len));
+    run(2, vector_add<2>(q, a, b, c, len));
+    run(4, vector_add<4>(q, a, b, c, len));
+    run(8, vector_add<8>(q, a, b, c, len));
+
+    sycl::free(a, q);
+    sycl::free(b, q);
+    sycl::free(c, q);
+    delete[] host_a;
+    delete[] host_b;
+    delete[] host_c;
+  } catch (sycl::exception const &e) {
+    // Catches exceptions in the host code.
+    std::cerr << "Caught a SYCL host exception:\n" << e.what() << "\n";
+
+    // Most likely the runtime couldn't find FPGA hardware!
+    if (e.code().value() == CL_DEVICE_NOT_FOUND) {
+      std::cerr << "If you are targeting an FPGA, please ensure that your "
+                   "system has a correctly configured FPGA board.\n";
+      std::cerr << "Run sys_check in the oneAPI root directory to verify.\n";
+      std::cerr << "If you are targeting the FPGA emulator, compile with "
+                   "-DFPGA_EMULATOR.\n";
+    }
+    std::terminate();
+  }
+
+  std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
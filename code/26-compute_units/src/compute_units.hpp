@@ -0,0 +1,59 @@
+#ifndef COMPUTE_UNITS_HPP
+#define COMPUTE_UNITS_HPP
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// oneAPI headers
+#include <sycl/sycl.hpp>
+
+////////////////////////////////////////////////////////////////////////
+//
+// Compute-unit replication.
+//
+// SubmitComputeUnits<kCopies, Name>(q, f) submits kCopies single_task
+// kernels named Name<kCopies, 0> ... Name<kCopies, kCopies - 1>. Every
+// kernel name is a separate kernel in the bitstream, so the compiler
+// builds kCopies compute units that run concurrently. The body f is
+// called with the id of its copy as a std::integral_constant, so it is a
+// compile-time constant inside each compute unit:
+//
+//   SubmitComputeUnits<4, VAddCUID>(q, [=](auto id) {
+//     auto [begin, end] = Partition(id, 4, len);
+//     for (int i = begin; i < end; i++) c[i] = a[i] + b[i];
+//   });
+//
+// The kernels are declared [[intel::kernel_args_restrict]]: the pointers
+// captured by f must not alias each other, e.g. the output of a compute
+// unit must not overlap its inputs. Without it every compute unit would
+// have to assume that its stores may change its loads, and would not
+// reach an initiation interval of 1.
+//
+// Partition splits [0, len) in kCopies contiguous slices whose sizes
+// differ by at most one element.
+//
+////////////////////////////////////////////////////////////////////////
+inline std::pair<int, int> Partition(int id, int copies, int len) {
+  const int base = len / copies;
+  const int extra = len % copies;
+  const int begin = id * base + std::min(id, extra);
+  return {begin, begin + base + (id < extra ? 1 : 0)};
+}
+
+template <int kCopies, template <int, int> class Name, typename F, int... ids>
+std::vector<sycl::event> SubmitComputeUnitsImpl(sycl::queue& q, F f,
+                                                std::integer_sequence<int, ids...>) {
+  return {q.single_task<Name<kCopies, ids>>([=]() [[intel::kernel_args_restrict]] {
+    f(std::integral_constant<int, ids>{});
+  })...};
+}
+
+template <int kCopies, template <int, int> class Name, typename F>
+std::vector<sycl::event> SubmitComputeUnits(sycl::queue& q, F f) {
+  static_assert(kCopies > 0, "at least one compute unit");
+  return SubmitComputeUnitsImpl<kCopies, Name>(q, f, std::make_integer_sequence<int, kCopies>{});
+}
+
+#endif
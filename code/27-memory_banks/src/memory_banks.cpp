@@ -0,0 +1,228 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+#include "memory_banks.hpp"
+
+// Elements per iteration of the vector add, 64 bytes for int
+constexpr int kVec = 16;
+constexpr int kTile = 16;
+
+// Forward declare the kernel names in the global scope. This is an FPGA best
+// practice that reduces name mangling in the optimization reports.
+template <Placement p> class VectorAddBankID;
+template <Placement p> class MatMultBankID;
+
+// Kernel time in ms from the profiling information of the event
+double kernel_time(const sycl::event& e) {
+  double start = e.get_profiling_info<sycl::info::event_profiling::command_start>();
+  double end = e.get_profiling_info<sycl::info::event_profiling::command_end>();
+  return (end - start) * 1e-6;
+}
+
+// c = a + b with a, b and c in the banks chosen by p; returns the kernel time
+template <Placement p>
+double vector_add(sycl::queue& q, const std::vector<int>& host_a,
+                  const std::vector<int>& host_b, std::vector<int>& host_c) {
+  const int len = host_a.size();
+  const size_t bytes = len * sizeof(int);
+  BankAllocator banks(q, p);
+  int* a = banks.allocate<int>(len);
+  int* b = banks.allocate<int>(len);
+  int* c = banks.allocate<int>(len);
+  q.memcpy(a, host_a.data(), bytes).wait();
+  q.memcpy(b, host_b.data(), bytes).wait();
+
+  BankPtr<const int, bank_of(p, 0)> arg_a{a};
+  BankPtr<const int, bank_of(p, 1)> arg_b{b};
+  BankPtr<int, bank_of(p, 2)> arg_c{c};
+  sycl::event e = q.single_task<VectorAddBankID<p>>([=]() [[intel::kernel_args_restrict]] {
+    for (int i = 0; i < len; i += kVec) {
+#pragma unroll
+      for (int k = 0; k < kVec; k++) arg_c[i + k] = arg_a[i + k] + arg_b[i + k];
+    }
+  });
+  e.wait();
+  q.memcpy(host_c.data(), c, bytes).wait();
+  return kernel_time(e);
+}
+
+// C = A x B with A, B and C in the banks chosen by p, tiled in local
+// memory as in 04-matmult_ndrange; returns the kernel time
+template <Placement p>
+double matmult(sycl::queue& q, const std::vector<float>& host_a,
+               const std::vector<float>& host_b, std::vector<float>& host_c, int n) {
+  const size_t bytes = size_t(n) * n * sizeof(float);
+  BankAllocator banks(q, p);
+  float* a = banks.allocate<float>(size_t(n) * n);
+  float* b = banks.allocate<float>(size_t(n) * n);
+  float* c = banks.allocate<float>(size_t(n) * n);
+  q.memcpy(a, host_a.data(), bytes).wait();
+  q.memcpy(b, host_b.data(), bytes).wait();
+
+  BankPtr<const float, bank_of(p, 0)> arg_a{a};
+  BankPtr<const float, bank_of(p, 1)> arg_b{b};
+  BankPtr<float, bank_of(p, 2)> arg_c{c};
+  sycl::event e = q.submit([&](sycl::handler& h) {
+    sycl::local_accessor<float, 2> tileA{{kTile, kTile}, h};
+    sycl::local_accessor<float, 2> tileB{{kTile, kTile}, h};
+    sycl::range<2> global(n, n);
+    sycl::range<2> local(kTile, kTile);
+    h.parallel_for<MatMultBankID<p>>(sycl::nd_range<2>{global, local},
+        [=](sycl::nd_item<2> item)
+            [[intel::max_work_group_size(1, kTile, kTile)]] {
+      int m = item.get_global_id()[0];
+      int col = item.get_global_id()[1];
+      int i = item.get_local_id()[0];
+      int j = item.get_local_id()[1];
+
+      float sum = 0;
+      for (int t = 0; t < n / kTile; t++) {
+        tileA[i][j] = arg_a[m * n + t * kTile + j];
+        tileB[i][j] = arg_b[(t * kTile + i) * n + col];
+        sycl::group_barrier(item.get_group());
+        for (int kk = 0; kk < kTile; kk++) sum += tileA[i][kk] * tileB[kk][j];
+        sycl::group_barrier(item.get_group());
+      }
+      arg_c[m * n + col] = sum;
+    });
+  });
+  e.wait();
+  q.memcpy(host_c.data(), c, bytes).wait();
+  return kernel_time(e);
+}
+
+void usage(const char* exe) {
+  std::cout << "Usage: \n" << exe << " [--size N] [--n N]"
+            << "\n\nFAILED\n";
+}
+
+int main(int argc, char* argv[]) {
+  int len = 1 << 24;
+  int n = 512;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--size") && i + 1 < argc) {
+      len = std::stoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--n") && i + 1 < argc) {
+      n = std::stoi(argv[++i]);
+    } else {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (len < kVec || len % kVec || n < kTile || n % kTile) {
+    std::cout << "--size must be a multiple of " << kVec << " and --n a multiple of "
+              << kTile << std::endl;
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  bool passed = true;
+  try {
+    // Use compile-time macros to select either:
+    //  - the FPGA emulator device (CPU emulation of the FPGA)
+    //  - the FPGA device (a real FPGA)
+    //  - the simulator device
+#if FPGA_SIMULATOR
+    auto selector = sycl::ext::intel::fpga_simulator_selector_v;
+#elif FPGA_HARDWARE
+    auto selector = sycl::ext::intel::fpga_selector_v;
+#else  // #if FPGA_EMULATOR
+    auto selector = sycl::ext::intel::fpga_emulator_selector_v;
+#endif
+
+    sycl::queue q(selector, sycl::property::queue::enable_profiling{});
+
+    auto device = q.get_device();
+    std::cout << "Running on device: "
+              << device.get_info<sycl::info::device::name>().c_str()
+              << std::endl;
+    std::cout << kBanks << " banks" << std::endl;
+
+    // vector add
+    std::vector<int> vec_a(len), vec_b(len), vec_c(len);
+    for (int i = 0; i < len; i++) {
+      vec_a[i] = i;
+      vec_b[i] = 3 * i - len;
+    }
+    const double vec_bytes = 3.0 * len * sizeof(int);
+    std::cout << "vector add on " << len << " ints" << std::endl;
+    std::cout << std::setw(12) << "placement" << std::setw(12) << "ms"
+              << std::setw(12) << "GB/s" << std::endl;
+    auto report_vector = [&](Placement p, double ms) {
+      std::cout << std::setw(12) << placement_name(p) << std::fixed
+                << std::setprecision(3) << std::setw(12) << ms
+                << std::setprecision(2) << std::setw(12)
+                << (ms > 0.0 ? vec_bytes / (ms * 1e6) : 0.0) << std::endl;
+      for (int i = 0; i < len; i++)
+        if (vec_c[i] != vec_a[i] + vec_b[i]) {
+          std::cout << placement_name(p) << ": c[" << i << "] = " << vec_c[i]
+                    << ", expected " << vec_a[i] + vec_b[i] << std::endl;
+          passed = false;
+          break;
+        }
+      std::fill(vec_c.begin(), vec_c.end(), 0);
+    };
+    report_vector(Placement::kDefault, vector_add<Placement::kDefault>(q, vec_a, vec_b, vec_c));
+    report_vector(Placement::kSameBank, vector_add<Placement::kSameBank>(q, vec_a, vec_b, vec_c));
+    report_vector(Placement::kSpread, vector_add<Placement::kSpread>(q, vec_a, vec_b, vec_c));
+
+    // matmult
+    std::vector<float> mat_a(n * n), mat_b(n * n), mat_c(n * n);
+    for (int i = 0; i < n * n; i++) {
+      mat_a[i] = (i % 17) * 0.125f;
+      mat_b[i] = (i % 13) * 0.25f - 1.0f;
+    }
+    std::vector<float> expected(n * n, 0.0f);
+    for (int i = 0; i < n; i++)
+      for (int k = 0; k < n; k++)
+        for (int j = 0; j < n; j++) expected[i * n + j] += mat_a[i * n + k] * mat_b[k * n + j];
+    // every work-item reads a row of A and a column of B through the tiles
+    const double mat_bytes = (2.0 * n * n * n / kTile + 1.0 * n * n) * sizeof(float);
+    std::cout << "matmult " << n << "x" << n << std::endl;
+    std::cout << std::setw(12) << "placement" << std::setw(12) << "ms"
+              << std::setw(12) << "GB/s" << std::setw(12) << "GFLOP/s" << std::endl;
+    auto report_matmult = [&](Placement p, double ms) {
+      std::cout << std::setw(12) << placement_name(p) << std::fixed
+                << std::setprecision(3) << std::setw(12) << ms
+                << std::setprecision(2) << std::setw(12)
+                << (ms > 0.0 ? mat_bytes / (ms * 1e6) : 0.0) << std::setw(12)
+                << (ms > 0.0 ? 2.0 * n * n * n / (ms * 1e6) : 0.0) << std::endl;
+      for (int i = 0; i < n * n; i++)
+        if (std::fabs(mat_c[i] - expected[i]) > 1e-4f * std::max(1.0f, std::fabs(expected[i]))) {
+          std::cout << placement_name(p) << ": C[" << i / n << ";" << i % n
+                    << "] = " << mat_c[i] << ", expected " << expected[i] << std::endl;
+          passed = false;
+          break;
+        }
+      std::fill(mat_c.begin(), mat_c.end(), 0.0f);
+    };
+    report_matmult(Placement::kDefault, matmult<Placement::kDefault>(q, mat_a, mat_b, mat_c, n));
+    report_matmult(Placement::kSameBank, matmult<Placement::kSameBank>(q, mat_a, mat_b, mat_c, n));
+    report_matmult(Placement::kSpread, matmult<Placement::kSpread>(q, mat_a, mat_b, mat_c, n));
+  } catch (sycl::exception const &e) {
+    // Catches exceptions in the host code.
+    std::cerr << "Caught a SYCL host exception:\n" << e.what() << "\n";
+
+    // Most likely the runtime couldn't find FPGA hardware!
+    if (e.code().value() == CL_DEVICE_NOT_FOUND) {
+      std::cerr << "If you are targeting an FPGA, please ensure that your "
+                   "system has a correctly configured FPGA board.\n";
+      std::cerr << "Run sys_check in the oneAPI root directory to verify.\n";
+      std::cerr << "If you are targeting the FPGA emulator, compile with "
+                   "-DFPGA_EMULATOR.\n";
+    }
+    std::terminate();
+  }
+
+  std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,114 @@
+#ifndef MEMORY_BANKS_HPP
+#define MEMORY_BANKS_HPP
+
+#include <string>
+#include <vector>
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+////////////////////////////////////////////////////////////////////////
+//
+// Memory-bank aware allocation.
+//
+// A board may expose several global memories (DDR banks, HBM pseudo
+// channels), each with a buffer_location id taken from the board_spec.xml
+// of the BSP. Without a location, the BSP places every array in its
+// default memory, where all the kernel accesses compete for the same
+// banks. The placement policy chooses the bank of the i-th array of a
+// kernel:
+//  - kDefault:  no location, the default memory of the BSP, interleaved
+//               across its banks by the BSP
+//  - kSameBank: every array in bank 0
+//  - kSpread:   array i in bank i % kBanks, e.g. A, B and C of a vector
+//               add on three different banks
+//
+// The allocation carries the location (USM buffer_location property),
+// and so does the kernel argument (BankPtr, an annotated_arg with the
+// buffer_location property when the compiler provides it): the compiler
+// then only connects the load/store units of that argument to that bank.
+// The bank of a kernel argument is a compile-time constant, so kernels
+// are instantiated per placement.
+//
+// kBanks defaults to 4, set -DNUM_BANKS=<n> in USER_FLAGS for other
+// boards.
+//
+////////////////////////////////////////////////////////////////////////
+#ifndef NUM_BANKS
+#define NUM_BANKS 4
+#endif
+constexpr int kBanks = NUM_BANKS;
+constexpr int kAnyBank = -1;
+constexpr size_t kAlignment = 64;
+
+enum class Placement { kDefault, kSameBank, kSpread };
+
+inline const char* placement_name(Placement p) {
+  switch (p) {
+    case Placement::kDefault: return "default";
+    case Placement::kSameBank: return "same bank";
+    default: return "spread";
+  }
+}
+
+// Bank of the array-th array of a kernel, kAnyBank for the default memory
+constexpr int bank_of(Placement p, int array) {
+  return p == Placement::kDefault ? kAnyBank
+         : p == Placement::kSameBank ? 0
+                                     : array % kBanks;
+}
+
+// Kernel argument pointing to an array in bank kBank
+template <typename T, int kBank>
+struct BankPtrType {
+#ifdef SYCL_EXT_ONEAPI_ANNOTATED_ARG
+  using type = sycl::ext::oneapi::experimental::annotated_arg<
+      T*, decltype(sycl::ext::oneapi::experimental::properties{
+              sycl::ext::intel::experimental::buffer_location<kBank>})>;
+#else
+  using type = T*;
+#endif
+};
+template <typename T>
+struct BankPtrType<T, kAnyBank> {
+  using type = T*;
+};
+template <typename T, int kBank>
+using BankPtr = typename BankPtrType<T, kBank>::type;
+
+// Allocates the arrays of a kernel, in order, in the banks chosen by the
+// placement, and frees them on destruction
+class BankAllocator {
+ public:
+  BankAllocator(sycl::queue& q, Placement placement)
+      : q_(q), placement_(placement) {}
+  BankAllocator(const BankAllocator&) = delete;
+  BankAllocator& operator=(const BankAllocator&) = delete;
+  ~BankAllocator() {
+    for (void* p : arrays_) sycl::free(p, q_);
+  }
+
+  template <typename T>
+  T* allocate(size_t n) {
+    int bank = bank_of(placement_, int(arrays_.size()));
+    T* p = (bank == kAnyBank)
+               ? sycl::aligned_alloc_device<T>(kAlignment, n, q_)
+               : sycl::aligned_alloc_device<T>(
+                     kAlignment, n, q_,
+                     sycl::property_list{sycl::ext::intel::experimental::
+                                             property::usm::buffer_location(bank)});
+    if (p == nullptr)
+      throw sycl::exception(sycl::make_error_code(sycl::errc::memory_allocation),
+                            "allocation failed in bank " + std::to_string(bank));
+    arrays_.push_back(p);
+    return p;
+  }
+
+ private:
+  sycl::queue& q_;
+  Placement placement_;
+  std::vector<void*> arrays_;
+};
+
+#endif
@@ -0,0 +1,209 @@
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+#include "lsu_variants.hpp"
+
+#define ALIGNMENT 64
+
+constexpr int kUnroll = 8;
+constexpr int kPatterns = 4;
+constexpr int kLSUs = 5;
+const char* kPatternNames[kPatterns] = {"sequential", "unrolled x8", "strided",
+                                        "struct field"};
+const char* kLSUNames[kLSUs] = {"default", "pipelined", "burst", "burst+cache",
+                                "prefetch"};
+
+// Kernel time in ms from the profiling information of the event
+double kernel_time(const sycl::event& e) {
+  double start = e.get_profiling_info<sycl::info::event_profiling::command_start>();
+  double end = e.get_profiling_info<sycl::info::event_profiling::command_end>();
+  return (end - start) * 1e-6;
+}
+
+double wait_time(sycl::event e) {
+  e.wait();
+  return kernel_time(e);
+}
+
+struct Arrays {
+  int len;
+  int stride;
+  const int* a;
+  const int* b;
+  int* c;
+  Fields* s;
+  std::vector<int> host_a, host_b, host_c;
+  std::vector<Fields> host_s;
+};
+
+bool check_add(const char* name, Arrays& d, sycl::queue& q) {
+  q.memcpy(d.host_c.data(), d.c, d.len * sizeof(int)).wait();
+  q.memset(d.c, 0, d.len * sizeof(int)).wait();
+  for (int i = 0; i < d.len; i++)
+    if (d.host_c[i] != d.host_a[i] + d.host_b[i]) {
+      std::cout << name << ": c[" << i << "] = " << d.host_c[i] << ", expected "
+                << d.host_a[i] + d.host_b[i] << std::endl;
+      return false;
+    }
+  return true;
+}
+
+bool check_fields(const char* name, Arrays& d, sycl::queue& q) {
+  std::vector<Fields> result(d.len);
+  q.memcpy(result.data(), d.s, d.len * sizeof(Fields)).wait();
+  q.memcpy(d.s, d.host_s.data(), d.len * sizeof(Fields)).wait();
+  for (int i = 0; i < d.len; i++)
+    if (result[i].C != (int)d.host_s[i].A + d.host_s[i].B) {
+      std::cout << name << ": s[" << i << "].C = " << result[i].C << ", expected "
+                << (int)d.host_s[i].A + d.host_s[i].B << std::endl;
+      return false;
+    }
+  return true;
+}
+
+// One column of the matrix: the kernel time of every access pattern with
+// the load-store unit LSU
+template <typename LSU>
+void measure(sycl::queue& q, Arrays& d, int column, double ms[kPatterns][kLSUs],
+             bool& passed) {
+  ms[0][column] = wait_time(stream_add<LSU>(q, d.a, d.b, d.c, d.len));
+  passed &= check_add(kPatternNames[0], d, q);
+  ms[1][column] = wait_time(stream_add_unrolled<LSU, kUnroll>(q, d.a, d.b, d.c, d.len));
+  passed &= check_add(kPatternNames[1], d, q);
+  ms[2][column] = wait_time(strided_add<LSU>(q, d.a, d.b, d.c, d.len, d.stride));
+  passed &= check_add(kPatternNames[2], d, q);
+  ms[3][column] = wait_time(struct_field<LSU>(q, d.s, d.len));
+  passed &= check_fields(kPatternNames[3], d, q);
+}
+
+void usage(const char* exe) {
+  std::cout << "Usage: \n" << exe << " [--size N] [--stride S]"
+            << "\n\nFAILED\n";
+}
+
+int main(int argc, char* argv[]) {
+  int len = 1 << 22;
+  int stride = 17;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--size") && i + 1 < argc) {
+      len = std::stoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--stride") && i + 1 < argc) {
+      stride = std::stoi(argv[++i]);
+    } else {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  // the strided pattern is a permutation for a power of two size and an
+  // odd stride
+  if (len < 1 || (len & (len - 1)) || stride < 1 || stride % 2 == 0) {
+    std::cout << "--size must be a power of two and --stride odd" << std::endl;
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  bool passed = true;
+  try {
+    // Use compile-time macros to select either:
+    //  - the FPGA emulator device (CPU emulation of the FPGA)
+    //  - the FPGA device (a real FPGA)
+    //  - the simulator device
+#if FPGA_SIMULATOR
+    auto selector = sycl::ext::intel::fpga_simulator_selector_v;
+#elif FPGA_HARDWARE
+    auto selector = sycl::ext::intel::fpga_selector_v;
+#else  // #if FPGA_EMULATOR
+    auto selector = sycl::ext::intel::fpga_emulator_selector_v;
+#endif
+
+    sycl::queue q(selector, sycl::property::queue::enable_profiling{});
+
+    auto device = q.get_device();
+    std::cout << "Running on device: "
+              << device.get_info<sycl::info::device::name>().c_str()
+              << std::endl;
+
+    Arrays d;
+    d.len = len;
+    d.stride = stride;
+    d.host_a.resize(len);
+    d.host_b.resize(len);
+    d.host_c.resize(len);
+    d.host_s.resize(len);
+    for (int i = 0; i < len; i++) {
+      d.host_a[i] = i;
+      d.host_b[i] = 5 * i + 3;
+      d.host_s[i].A = char(i % 128);
+      d.host_s[i].B = 7 * i;
+      d.host_s[i].C = 0;
+    }
+    const size_t bytes = len * sizeof(int);
+    int* a = static_cast<int*>(sycl::aligned_alloc_device(ALIGNMENT, bytes, q));
+    int* b = static_cast<int*>(sycl::aligned_alloc_device(ALIGNMENT, bytes, q));
+    int* c = static_cast<int*>(sycl::aligned_alloc_device(ALIGNMENT, bytes, q));
+    Fields* s = static_cast<Fields*>(sycl::aligned_alloc_device(ALIGNMENT, len * sizeof(Fields), q));
+    q.memcpy(a, d.host_a.data(), bytes).wait();
+    q.memcpy(b, d.host_b.data(), bytes).wait();
+    q.memset(c, 0, bytes).wait();
+    q.memcpy(s, d.host_s.data(), len * sizeof(Fields)).wait();
+    d.a = a;
+    d.b = b;
+    d.c = c;
+    d.s = s;
+
+    double ms[kPatterns][kLSUs];
+    measure<DefaultLSU>(q, d, 0, ms, passed);
+    measure<PipelinedLSU>(q, d, 1, ms, passed);
+    measure<BurstLSU>(q, d, 2, ms, passed);
+    measure<CachedLSU>(q, d, 3, ms, passed);
+    measure<PrefetchLSU>(q, d, 4, ms, passed);
+
+    // bytes moved per element: two loads and a store, or a char, an int
+    // and a store of an int for the structure
+    const double pattern_bytes[kPatterns] = {3.0 * bytes, 3.0 * bytes, 3.0 * bytes,
+                                             (1.0 + 2 * sizeof(int)) * len};
+    std::cout << len << " elements, stride " << stride << ", GB/s" << std::endl;
+    std::cout << std::setw(14) << "pattern";
+    for (int l = 0; l < kLSUs; l++) std::cout << std::setw(13) << kLSUNames[l];
+    std::cout << std::setw(13) << "best" << std::endl;
+    for (int p = 0; p < kPatterns; p++) {
+      std::cout << std::setw(14) << kPatternNames[p] << std::fixed
+                << std::setprecision(2);
+      int best = 0;
+      for (int l = 0; l < kLSUs; l++) {
+        std::cout << std::setw(13)
+                  << (ms[p][l] > 0.0 ? pattern_bytes[p] / (ms[p][l] * 1e6) : 0.0);
+        if (ms[p][l] < ms[p][best]) best = l;
+      }
+      std::cout << std::setw(13) << kLSUNames[best] << std::endl;
+    }
+
+    sycl::free(a, q);
+    sycl::free(b, q);
+    sycl::free(c, q);
+    sycl::free(s, q);
+  } catch (sycl::exception const &e) {
+    // Catches exceptions in the host code.
+    std::cerr << "Caught a SYCL host exception:\n" << e.what() << "\n";
+
+    // Most likely the runtime couldn't find FPGA hardware!
+    if (e.code().value() == CL_DEVICE_NOT_FOUND) {
+      std::cerr << "If you are targeting an FPGA, please ensure that your "
+                   "system has a correctly configured FPGA board.\n";
+      std::cerr << "Run sys_check in the oneAPI root directory to verify.\n";
+      std::cerr << "If you are targeting the FPGA emulator, compile with "
+                   "-DFPGA_EMULATOR.\n";
+    }
+    std::terminate();
+  }
+
+  std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
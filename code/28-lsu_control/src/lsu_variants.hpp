@@ -0,0 +1,100 @@
+#ifndef LSU_VARIANTS_HPP
+#define LSU_VARIANTS_HPP
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+////////////////////////////////////////////////////////////////////////
+//
+// Load-store unit controls for streaming kernels.
+//
+// The loads of the kernels below go through an LSU type:
+//  - DefaultLSU:   plain pointer access, the compiler picks the LSU
+//  - PipelinedLSU: lsu<>, no coalescing, one access per request
+//  - BurstLSU:     burst-coalesced, consecutive requests merged in bursts
+//  - CachedLSU:    burst-coalesced with a 1 KiB cache, for data reused
+//                  across iterations
+//  - PrefetchLSU:  prefetching, reads ahead of a sequential stream
+//
+// The kernels reproduce the streaming loads of the samples:
+//  - stream_add:          VectorAdd of 02-with_data_alignment
+//  - stream_add_unrolled: VAdd<N> of 09-loop_unroll
+//  - strided_add:         the same with a strided (permuted) index
+//  - struct_field:        test_structure of 10-alignment, fields of an
+//                         array of structures
+//
+////////////////////////////////////////////////////////////////////////
+struct DefaultLSU {
+  template <typename P>
+  static auto load(P p) { return *p; }
+};
+using PipelinedLSU = sycl::ext::intel::lsu<>;
+using BurstLSU = sycl::ext::intel::lsu<sycl::ext::intel::burst_coalesce<true>,
+                                       sycl::ext::intel::statically_coalesce<false>>;
+using CachedLSU = sycl::ext::intel::lsu<sycl::ext::intel::burst_coalesce<true>,
+                                        sycl::ext::intel::cache<1024>,
+                                        sycl::ext::intel::statically_coalesce<false>>;
+using PrefetchLSU = sycl::ext::intel::lsu<sycl::ext::intel::prefetch<true>,
+                                          sycl::ext::intel::statically_coalesce<false>>;
+
+// Load *p through the load-store unit LSU
+template <typename LSU, typename T>
+T load(const T* p) {
+  return LSU::load(sycl::address_space_cast<sycl::access::address_space::global_space,
+                                            sycl::access::decorated::no>(p));
+}
+
+// Same layout as mystruct in 10-alignment
+struct Fields {
+  char A;
+  int B;
+  int C;
+};
+
+// Forward declare the kernel names in the global scope. This is an FPGA best
+// practice that reduces name mangling in the optimization reports.
+template <typename LSU> class StreamAddID;
+template <typename LSU, int unroll_factor> class StreamAddUnrolledID;
+template <typename LSU> class StridedAddID;
+template <typename LSU> class StructFieldID;
+
+template <typename LSU>
+sycl::event stream_add(sycl::queue& q, const int* a, const int* b, int* c, int len) {
+  return q.single_task<StreamAddID<LSU>>([=]() [[intel::kernel_args_restrict]] {
+    for (int i = 0; i < len; i++) c[i] = load<LSU>(a + i) + load<LSU>(b + i);
+  });
+}
+
+template <typename LSU, int unroll_factor>
+sycl::event stream_add_unrolled(sycl::queue& q, const int* a, const int* b,
+                                int* c, int len) {
+  return q.single_task<StreamAddUnrolledID<LSU, unroll_factor>>(
+      [=]() [[intel::kernel_args_restrict]] {
+    #pragma unroll unroll_factor
+    for (int i = 0; i < len; i++) c[i] = load<LSU>(a + i) + load<LSU>(b + i);
+  });
+}
+
+// len a power of two and stride odd: i * stride visits every element once,
+// computed unsigned so that the product wraps instead of overflowing
+template <typename LSU>
+sycl::event strided_add(sycl::queue& q, const int* a, const int* b, int* c,
+                        int len, int stride) {
+  return q.single_task<StridedAddID<LSU>>([=]() [[intel::kernel_args_restrict]] {
+    for (int i = 0; i < len; i++) {
+      int idx = int((unsigned(i) * unsigned(stride)) & unsigned(len - 1));
+      c[idx] = load<LSU>(a + idx) + load<LSU>(b + idx);
+    }
+  });
+}
+
+template <typename LSU>
+sycl::event struct_field(sycl::queue& q, Fields* s, int len) {
+  return q.single_task<StructFieldID<LSU>>([=]() {
+    for (int i = 0; i < len; i++)
+      s[i].C = (int)load<LSU>(&s[i].A) + load<LSU>(&s[i].B);
+  });
+}
+
+#endif
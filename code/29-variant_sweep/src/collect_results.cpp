@@ -0,0 +1,226 @@
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////
+//
+// Results collector of the variant sweep (host only).
+//
+// Scans a build directory for the early-image reports of the sweep,
+// <target>_<type>_u<U>_s<S>_wg<W>.report.prj, reads the estimated
+// resources of each report (the "Total" row of the estimatedResources
+// table) and ranks the variants:
+//  - estimated throughput: SIMD x unroll elements per cycle at --fmax MHz,
+//    3 accesses of sizeof(type) per element, capped at --bandwidth GB/s
+//    when given, since past it the variants are memory bound;
+//  - then area, fewest ALUTs first.
+// Measured times from variant_sweep --csv are added with --measured.
+//
+////////////////////////////////////////////////////////////////////////
+namespace fs = std::filesystem;
+
+struct Entry {
+  std::string name;
+  std::string type;
+  int unroll = 0, simd = 0, wg = 0;
+  bool has_area = false;
+  double aluts = 0, ffs = 0, rams = 0, dsps = 0;
+  double gbs = 0.0;
+  double measured_ms = -1.0;
+};
+
+std::string read_file(const fs::path& path) {
+  std::ifstream file(path);
+  std::stringstream s;
+  s << file.rdbuf();
+  return s.str();
+}
+
+// Numbers of the JSON array starting at text[pos] == '['
+std::vector<double> parse_numbers(const std::string& text, size_t pos) {
+  std::vector<double> values;
+  size_t end = text.find(']', pos);
+  if (end == std::string::npos) return values;
+  std::stringstream s(text.substr(pos + 1, end - pos - 1));
+  std::string item;
+  while (std::getline(s, item, ',')) {
+    item.erase(std::remove_if(item.begin(), item.end(),
+                              [](char c) { return c == '"' || c == ' '; }),
+               item.end());
+    try {
+      values.push_back(std::stod(item));
+    } catch (...) {
+      values.push_back(0.0);
+    }
+  }
+  return values;
+}
+
+// Strings of the JSON array starting at text[pos] == '['
+std::vector<std::string> parse_strings(const std::string& text, size_t pos) {
+  std::vector<std::string> values;
+  size_t end = text.find(']', pos);
+  for (size_t q = text.find('"', pos); q != std::string::npos && q < end;) {
+    size_t close = text.find('"', q + 1);
+    values.push_back(text.substr(q + 1, close - q - 1));
+    q = text.find('"', close + 1);
+  }
+  return values;
+}
+
+// Estimated resources from the report data of a .report.prj directory
+bool read_area(const fs::path& prj, Entry& entry) {
+  for (const char* candidate : {"reports/resources/json/summary.json",
+                                "reports/lib/report_data.js",
+                                "reports/resources/report_data.js"}) {
+    fs::path path = prj / candidate;
+    if (!fs::exists(path)) continue;
+    std::string text = read_file(path);
+    size_t table = text.find("\"estimatedResources\"");
+    if (table == std::string::npos) continue;
+
+    std::vector<std::string> columns = {"", "ALUTs", "FFs", "RAMs", "DSPs"};
+    size_t cols = text.find("\"columns\"", table);
+    size_t total = text.find("\"Total\"", table);
+    if (total == std::string::npos) continue;
+    if (cols != std::string::npos && cols < total)
+      columns = parse_strings(text, text.find('[', cols));
+    size_t data = text.find("\"data\"", total);
+    if (data == std::string::npos) continue;
+    std::vector<double> values = parse_numbers(text, text.find('[', data));
+
+    // the first column is the name of the row, not in data
+    for (size_t c = 1; c < columns.size() && c - 1 < values.size(); c++) {
+      const std::string& column = columns[c];
+      double v = values[c - 1];
+      if (column.find("ALUT") != std::string::npos) entry.aluts = v;
+      else if (column.find("FF") != std::string::npos) entry.ffs = v;
+      else if (column.find("RAM") != std::string::npos) entry.rams = v;
+      else if (column.find("DSP") != std::string::npos) entry.dsps = v;
+    }
+    entry.has_area = true;
+    return true;
+  }
+  return false;
+}
+
+int type_size(const std::string& type) { return type == "double" ? 8 : 4; }
+
+void usage(const char* exe) {
+  std::cout << "Usage: \n" << exe
+            << " <build dir> [--fmax MHz] [--bandwidth GB/s] [--measured <csv>]"
+               " [--csv <file>]"
+               "\n\nFAILED\n";
+}
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+  fs::path dir = argv[1];
+  double fmax = 300.0;
+  double bandwidth = 0.0;
+  std::string measured_path, csv_path;
+  for (int i = 2; i < argc; i++) {
+    if (!strcmp(argv[i], "--fmax") && i + 1 < argc) {
+      fmax = std::stod(argv[++i]);
+    } else if (!strcmp(argv[i], "--bandwidth") && i + 1 < argc) {
+      bandwidth = std::stod(argv[++i]);
+    } else if (!strcmp(argv[i], "--measured") && i + 1 < argc) {
+      measured_path = argv[++i];
+    } else if (!strcmp(argv[i], "--csv") && i + 1 < argc) {
+      csv_path = argv[++i];
+    } else {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (!fs::is_directory(dir)) {
+    std::cout << dir << " is not a directory" << std::endl;
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  const std::regex tag(R"(_((int|float|double)_u(\d+)_s(\d+)_wg(\d+))\.report\.prj$)");
+  std::vector<Entry> entries;
+  for (const fs::directory_entry& d : fs::directory_iterator(dir)) {
+    std::smatch m;
+    std::string file = d.path().filename().string();
+    if (!d.is_directory() || !std::regex_search(file, m, tag)) continue;
+    Entry e;
+    e.name = m[1];
+    e.type = m[2];
+    e.unroll = std::stoi(m[3]);
+    e.simd = std::stoi(m[4]);
+    e.wg = std::stoi(m[5]);
+    if (!read_area(d.path(), e))
+      std::cout << "no estimated resources in " << d.path() << std::endl;
+    e.gbs = e.simd * e.unroll * 3.0 * type_size(e.type) * fmax * 1e-3;
+    if (bandwidth > 0.0) e.gbs = std::min(e.gbs, bandwidth);
+    entries.push_back(e);
+  }
+  if (entries.empty()) {
+    std::cout << "no report of the sweep in " << dir << "\n\nFAILED\n";
+    return EXIT_FAILURE;
+  }
+
+  if (!measured_path.empty()) {
+    std::ifstream file(measured_path);
+    std::map<std::string, double> ms;
+    std::string line;
+    std::getline(file, line);  // header
+    while (std::getline(file, line)) {
+      std::stringstream s(line);
+      std::string name, per_cycle, time;
+      std::getline(s, name, ',');
+      std::getline(s, per_cycle, ',');
+      std::getline(s, time, ',');
+      if (!time.empty()) ms[name] = std::stod(time);
+    }
+    for (Entry& e : entries)
+      if (ms.count(e.name)) e.measured_ms = ms[e.name];
+  }
+
+  std::sort(entries.begin(), entries.end(), [](const Entry& x, const Entry& y) {
+    if (x.gbs != y.gbs) return x.gbs > y.gbs;
+    if (x.has_area != y.has_area) return x.has_area;
+    return x.aluts < y.aluts;
+  });
+
+  std::cout << std::setw(6) << "rank" << std::setw(20) << "variant"
+            << std::setw(12) << "est. GB/s" << std::setw(10) << "ALUTs"
+            << std::setw(10) << "FFs" << std::setw(8) << "RAMs"
+            << std::setw(8) << "DSPs" << std::setw(14) << "GB/s/kALUT"
+            << std::setw(12) << "measured ms" << std::endl;
+  std::ofstream csv;
+  if (!csv_path.empty()) {
+    csv.open(csv_path);
+    csv << "rank,variant,type,unroll,simd,wg,est_gbs,aluts,ffs,rams,dsps,measured_ms\n";
+  }
+  for (size_t i = 0; i < entries.size(); i++) {
+    const Entry& e = entries[i];
+    std::cout << std::setw(6) << i + 1 << std::setw(20) << e.name << std::fixed
+              << std::setprecision(2) << std::setw(12) << e.gbs
+              << std::setprecision(0) << std::setw(10) << e.aluts
+              << std::setw(10) << e.ffs << std::setw(8) << e.rams
+              << std::setw(8) << e.dsps << std::setprecision(3) << std::setw(14)
+              << (e.aluts > 0 ? e.gbs / (e.aluts * 1e-3) : 0.0);
+    if (e.measured_ms >= 0.0) std::cout << std::setw(12) << e.measured_ms;
+    std::cout << std::endl;
+    if (csv.is_open())
+      csv << i + 1 << "," << e.name << "," << e.type << "," << e.unroll << ","
+          << e.simd << "," << e.wg << "," << e.gbs << "," << e.aluts << ","
+          << e.ffs << "," << e.rams << "," << e.dsps << "," << e.measured_ms
+          << "\n";
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,139 @@
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+#include "variants.hpp"
+
+#define ALIGNMENT 64
+
+// Kernel time in ms from the profiling information of the event
+double kernel_time(const sycl::event& e) {
+  double start = e.get_profiling_info<sycl::info::event_profiling::command_start>();
+  double end = e.get_profiling_info<sycl::info::event_profiling::command_end>();
+  return (end - start) * 1e-6;
+}
+
+void usage(const char* exe) {
+  std::cout << "Usage: \n" << exe << " [--size N] [--csv <file>]"
+            << "\n\nFAILED\n";
+}
+
+int main(int argc, char* argv[]) {
+  int len = 1 << 20;
+  std::string csv_path;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--size") && i + 1 < argc) {
+      len = std::stoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--csv") && i + 1 < argc) {
+      csv_path = argv[++i];
+    } else {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (len < 1) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  bool passed = true;
+  try {
+    // Use compile-time macros to select either:
+    //  - the FPGA emulator device (CPU emulation of the FPGA)
+    //  - the FPGA device (a real FPGA)
+    //  - the simulator device
+#if FPGA_SIMULATOR
+    auto selector = sycl::ext::intel::fpga_simulator_selector_v;
+#elif FPGA_HARDWARE
+    auto selector = sycl::ext::intel::fpga_selector_v;
+#else  // #if FPGA_EMULATOR
+    auto selector = sycl::ext::intel::fpga_emulator_selector_v;
+#endif
+
+    sycl::queue q(selector, sycl::property::queue::enable_profiling{});
+
+    auto device = q.get_device();
+    std::cout << "Running on device: "
+              << device.get_info<sycl::info::device::name>().c_str()
+              << std::endl;
+
+    std::ofstream csv;
+    if (!csv_path.empty()) {
+      csv.open(csv_path);
+      csv << "variant,elements_per_cycle,ms,gbs\n";
+    }
+
+    std::cout << "vector add on " << len << " elements" << std::endl;
+    std::cout << std::setw(20) << "variant" << std::setw(12) << "elem/cycle"
+              << std::setw(12) << "ms" << std::setw(12) << "GB/s" << std::endl;
+    SweepGrid::for_each([&](auto variant) {
+      using V = decltype(variant);
+      using T = typename V::type;
+      const std::string name = V::name();
+      if (len % (V::unroll * V::wg)) {
+        std::cout << std::setw(20) << name << "  skipped, --size is not a multiple of "
+                  << V::unroll * V::wg << std::endl;
+        return;
+      }
+
+      std::vector<T> host_a(len), host_b(len), host_c(len);
+      for (int i = 0; i < len; i++) {
+        host_a[i] = T(i % 1000);
+        host_b[i] = T((3 * i) % 1000);
+      }
+      const size_t bytes = len * sizeof(T);
+      T* a = static_cast<T*>(sycl::aligned_alloc_device(ALIGNMENT, bytes, q));
+      T* b = static_cast<T*>(sycl::aligned_alloc_device(ALIGNMENT, bytes, q));
+      T* c = static_cast<T*>(sycl::aligned_alloc_device(ALIGNMENT, bytes, q));
+      q.memcpy(a, host_a.data(), bytes).wait();
+      q.memcpy(b, host_b.data(), bytes).wait();
+
+      sycl::event e = vector_add<V>(q, a, b, c, len);
+      e.wait();
+      double ms = kernel_time(e);
+      q.memcpy(host_c.data(), c, bytes).wait();
+
+      const int per_cycle = V::simd * V::unroll;
+      const double gbs = ms > 0.0 ? 3.0 * bytes / (ms * 1e6) : 0.0;
+      std::cout << std::setw(20) << name << std::setw(12) << per_cycle
+                << std::fixed << std::setprecision(3) << std::setw(12) << ms
+                << std::setprecision(2) << std::setw(12) << gbs << std::endl;
+      if (csv.is_open())
+        csv << name << "," << per_cycle << "," << ms << "," << gbs << "\n";
+
+      for (int i = 0; i < len; i++)
+        if (host_c[i] != host_a[i] + host_b[i]) {
+          std::cout << name << ": c[" << i << "] = " << host_c[i] << ", expected "
+                    << host_a[i] + host_b[i] << std::endl;
+          passed = false;
+          break;
+        }
+      sycl::free(a, q);
+      sycl::free(b, q);
+      sycl::free(c, q);
+    });
+  } catch (sycl::exception const &e) {
+    // Catches exceptions in the host code.
+    std::cerr << "Caught a SYCL host exception:\n" << e.what() << "\n";
+
+    // Most likely the runtime couldn't find FPGA hardware!
+    if (e.code().value() == CL_DEVICE_NOT_FOUND) {
+      std::cerr << "If you are targeting an FPGA, please ensure that your "
+                   "system has a correctly configured FPGA board.\n";
+      std::cerr << "Run sys_check in the oneAPI root directory to verify.\n";
+      std::cerr << "If you are targeting the FPGA emulator, compile with "
+                   "-DFPGA_EMULATOR.\n";
+    }
+    std::terminate();
+  }
+
+  std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,109 @@
+#ifndef VARIANTS_HPP
+#define VARIANTS_HPP
+
+#include <string>
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+////////////////////////////////////////////////////////////////////////
+//
+// Compile-time kernel variants.
+//
+// A Variant<T, kUnroll, kSimd, kWG> is the vector add of
+// 08-vector_add_ndrange_profiling_simd on elements of type T, with
+// num_simd_work_items(kSimd), a work-group size of kWG and kUnroll
+// elements per work-item (unrolled, strided by the global size so that
+// consecutive work-items read consecutive elements). Each variant has its
+// own kernel name, VariantID<T, kUnroll, kSimd, kWG>.
+//
+// Grid<Types<...>, Ints<unrolls...>, Ints<simds...>, Ints<wgs...>>
+// expands the cartesian product and calls f(Variant{}) for every valid
+// combination (kSimd must divide kWG).
+//
+// SweepGrid is the grid of this build: the whole default grid, or a
+// single variant when VARIANT_TYPE, VARIANT_UNROLL, VARIANT_SIMD and
+// VARIANT_WG are defined, which is how the CMake sweep builds one report
+// per variant.
+//
+////////////////////////////////////////////////////////////////////////
+template <typename... Ts> struct Types {};
+template <int... Vs> struct Ints {};
+
+template <typename T> const char* type_name();
+template <> inline const char* type_name<int>() { return "int"; }
+template <> inline const char* type_name<float>() { return "float"; }
+template <> inline const char* type_name<double>() { return "double"; }
+
+template <typename T, int kUnroll, int kSimd, int kWG>
+struct Variant {
+  using type = T;
+  static constexpr int unroll = kUnroll;
+  static constexpr int simd = kSimd;
+  static constexpr int wg = kWG;
+  static constexpr bool valid = kUnroll > 0 && kSimd > 0 && kWG % kSimd == 0;
+
+  // Same spelling as the tags of the CMake sweep: <type>_u<U>_s<S>_wg<W>
+  static std::string name() {
+    return std::string(type_name<T>()) + "_u" + std::to_string(kUnroll) + "_s" +
+           std::to_string(kSimd) + "_wg" + std::to_string(kWG);
+  }
+};
+
+template <typename TypesT, typename UnrollsT, typename SimdsT, typename WGsT>
+struct Grid;
+
+template <typename... Ts, int... Us, int... Ss, int... Ws>
+struct Grid<Types<Ts...>, Ints<Us...>, Ints<Ss...>, Ints<Ws...>> {
+  template <typename F>
+  static void for_each(F&& f) { (for_type<Ts>(f), ...); }
+
+ private:
+  template <typename T, typename F>
+  static void for_type(F& f) { (for_unroll<T, Us>(f), ...); }
+  template <typename T, int U, typename F>
+  static void for_unroll(F& f) { (for_simd<T, U, Ss>(f), ...); }
+  template <typename T, int U, int S, typename F>
+  static void for_simd(F& f) { (visit<Variant<T, U, S, Ws>>(f), ...); }
+  template <typename V, typename F>
+  static void visit(F& f) {
+    if constexpr (V::valid) f(V{});
+  }
+};
+
+#if defined(VARIANT_TYPE) && defined(VARIANT_UNROLL) && defined(VARIANT_SIMD) && defined(VARIANT_WG)
+using SweepGrid = Grid<Types<VARIANT_TYPE>, Ints<VARIANT_UNROLL>,
+                       Ints<VARIANT_SIMD>, Ints<VARIANT_WG>>;
+#else
+using SweepGrid = Grid<Types<int, float>, Ints<1, 2, 4>, Ints<1, 4, 8>,
+                       Ints<64, 128>>;
+#endif
+
+// Forward declare the kernel name in the global scope. This is an FPGA best
+// practice that reduces name mangling in the optimization reports.
+template <typename T, int kUnroll, int kSimd, int kWG> class VariantID;
+
+// c = a + b, len a multiple of V::unroll * V::wg
+template <typename V>
+sycl::event vector_add(sycl::queue& q, const typename V::type* a,
+                       const typename V::type* b, typename V::type* c, int len) {
+  constexpr int kUnroll = V::unroll;
+  constexpr int kSimd = V::simd;
+  constexpr int kWG = V::wg;
+  const int items = len / kUnroll;
+  return q.parallel_for<VariantID<typename V::type, kUnroll, kSimd, kWG>>(
+      sycl::nd_range<1>(sycl::range<1>(items), sycl::range<1>(kWG)),
+      [=](sycl::nd_item<1> it) [[intel::kernel_args_restrict,
+                                 intel::num_simd_work_items(kSimd),
+                                 sycl::reqd_work_group_size(1, 1, kWG)]] {
+    const int gid = it.get_global_id(0);
+    #pragma unroll
+    for (int k = 0; k < kUnroll; k++) {
+      const int idx = gid + k * items;
+      c[idx] = a[idx] + b[idx];
+    }
+  });
+}
+
+#endif
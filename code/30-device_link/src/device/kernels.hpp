@@ -0,0 +1,36 @@
+#ifndef KERNELS_HPP
+#define KERNELS_HPP
+
+#include <vector>
+
+// oneAPI headers
+#include <sycl/sycl.hpp>
+
+////////////////////////////////////////////////////////////////////////
+//
+// Device interface of the sample.
+//
+// The kernels are defined in the translation units of src/device and
+// compiled into a device image (-fsycl-link=image); the host code only
+// sees these declarations. As long as this header and src/device do not
+// change, the host can be edited and re-linked against the same image
+// without any device compilation.
+//
+// n must be a multiple of kWorkGroupSize, the pointers are USM device
+// allocations, and the kernels run after the events of deps.
+//
+////////////////////////////////////////////////////////////////////////
+constexpr int kWorkGroupSize = 128;
+constexpr int kSimdWorkItems = 8;
+
+// c = a + b
+sycl::event vector_add(sycl::queue &q, const float *a, const float *b,
+                       float *c, size_t n,
+                       const std::vector<sycl::event> &deps = {});
+
+// y = alpha * x
+sycl::event vector_scale(sycl::queue &q, float alpha, const float *x,
+                         float *y, size_t n,
+                         const std::vector<sycl::event> &deps = {});
+
+#endif
@@ -0,0 +1,25 @@
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+#include "kernels.hpp"
+
+// Forward declare the kernel name in the global scope. This is an FPGA best
+// practice that reduces name mangling in the optimization reports.
+class VectorAddID;
+
+sycl::event vector_add(sycl::queue &q, const float *a, const float *b,
+                       float *c, size_t n,
+                       const std::vector<sycl::event> &deps) {
+  return q.submit([&](sycl::handler &h) {
+    h.depends_on(deps);
+    h.parallel_for<VectorAddID>(
+        sycl::nd_range<1>(sycl::range<1>(n), sycl::range<1>(kWorkGroupSize)),
+        [=](sycl::nd_item<1> it)
+            [[intel::num_simd_work_items(kSimdWorkItems),
+              sycl::reqd_work_group_size(1, 1, kWorkGroupSize)]] {
+              auto gid = it.get_global_id(0);
+              c[gid] = a[gid] + b[gid];
+            });
+  });
+}
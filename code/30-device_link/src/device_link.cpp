@@ -0,0 +1,147 @@
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// oneAPI headers
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+
+#include "device/kernels.hpp"
+
+////////////////////////////////////////////////////////////////////////
+//
+// Host code of the sample: argument parsing, data, timing and
+// verification. It holds no kernel; the kernels are called through
+// device/kernels.hpp and come from the device image linked in, so that
+// editing this file only costs a host compilation and a link.
+//
+////////////////////////////////////////////////////////////////////////
+constexpr size_t kAlignment = 64;
+
+// Kernel time in ms from the profiling information of the event
+double kernel_time(const sycl::event& e) {
+  double start = e.get_profiling_info<sycl::info::event_profiling::command_start>();
+  double end = e.get_profiling_info<sycl::info::event_profiling::command_end>();
+  return (end - start) * 1e-6;
+}
+
+void usage(const char* exe) {
+  std::cout << "Usage: \n" << exe << " [--size N] [--alpha A] [--iterations I]"
+            << "\n\nFAILED\n";
+}
+
+int main(int argc, char* argv[]) {
+  int len = 1 << 20;
+  float alpha = 2.0f;
+  int iterations = 10;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--size") && i + 1 < argc) {
+      len = std::stoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--alpha") && i + 1 < argc) {
+      alpha = std::stof(argv[++i]);
+    } else if (!strcmp(argv[i], "--iterations") && i + 1 < argc) {
+      iterations = std::stoi(argv[++i]);
+    } else {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (len < 1 || len % kWorkGroupSize || iterations < 1) {
+    std::cout << "--size must be a multiple of " << kWorkGroupSize << std::endl;
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  bool passed = true;
+  try {
+    // Use compile-time macros to select either:
+    //  - the FPGA emulator device (CPU emulation of the FPGA)
+    //  - the FPGA device (a real FPGA)
+    //  - the simulator device
+#if FPGA_SIMULATOR
+    auto selector = sycl::ext::intel::fpga_simulator_selector_v;
+#elif FPGA_HARDWARE
+    auto selector = sycl::ext::intel::fpga_selector_v;
+#else  // #if FPGA_EMULATOR
+    auto selector = sycl::ext::intel::fpga_emulator_selector_v;
+#endif
+
+    sycl::queue q(selector, sycl::property::queue::enable_profiling{});
+
+    auto device = q.get_device();
+    std::cout << "Running on device: "
+              << device.get_info<sycl::info::device::name>().c_str()
+              << std::endl;
+
+    std::vector<float> host_a(len), host_b(len), host_d(len);
+    for (int i = 0; i < len; i++) {
+      host_a[i] = float(i % 1000);
+      host_b[i] = float((3 * i) % 1000);
+    }
+    const size_t bytes = len * sizeof(float);
+    float* a = static_cast<float*>(sycl::aligned_alloc_device(kAlignment, bytes, q));
+    float* b = static_cast<float*>(sycl::aligned_alloc_device(kAlignment, bytes, q));
+    float* c = static_cast<float*>(sycl::aligned_alloc_device(kAlignment, bytes, q));
+    float* d = static_cast<float*>(sycl::aligned_alloc_device(kAlignment, bytes, q));
+    q.memcpy(a, host_a.data(), bytes).wait();
+    q.memcpy(b, host_b.data(), bytes).wait();
+
+    // d = alpha * (a + b), the two kernels of the device image chained
+    double add_ms = 0.0, scale_ms = 0.0;
+    for (int it = 0; it < iterations; it++) {
+      sycl::event add = vector_add(q, a, b, c, len);
+      sycl::event scale = vector_scale(q, alpha, c, d, len, {add});
+      scale.wait();
+      add_ms += kernel_time(add);
+      scale_ms += kernel_time(scale);
+    }
+    q.memcpy(host_d.data(), d, bytes).wait();
+
+    std::cout << len << " elements, " << iterations << " iterations"
+              << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << std::setw(14) << "vector_add" << std::setw(12)
+              << add_ms / iterations << " ms" << std::setw(10)
+              << std::setprecision(2)
+              << (add_ms > 0.0 ? 3.0 * bytes * iterations / (add_ms * 1e6) : 0.0)
+              << " GB/s" << std::endl;
+    std::cout << std::setprecision(3) << std::setw(14) << "vector_scale"
+              << std::setw(12) << scale_ms / iterations << " ms" << std::setw(10)
+              << std::setprecision(2)
+              << (scale_ms > 0.0 ? 2.0 * bytes * iterations / (scale_ms * 1e6) : 0.0)
+              << " GB/s" << std::endl;
+
+    for (int i = 0; i < len; i++) {
+      float expected = alpha * (host_a[i] + host_b[i]);
+      if (host_d[i] != expected) {
+        std::cout << "d[" << i << "] = " << host_d[i] << ", expected "
+                  << expected << std::endl;
+        passed = false;
+        break;
+      }
+    }
+
+    sycl::free(a, q);
+    sycl::free(b, q);
+    sycl::free(c, q);
+    sycl::free(d, q);
+  } catch (sycl::exception const &e) {
+    // Catches exceptions in the host code.
+    std::cerr << "Caught a SYCL host exception:\n" << e.what() << "\n";
+
+    // Most likely the runtime couldn't find FPGA hardware!
+    if (e.code().value() == CL_DEVICE_NOT_FOUND) {
+      std::cerr << "If you are targeting an FPGA, please ensure that your "
+                   "system has a correctly configured FPGA board.\n";
+      std::cerr << "Run sys_check in the oneAPI root directory to verify.\n";
+      std::cerr << "If you are targeting the FPGA emulator, compile with "
+                   "-DFPGA_EMULATOR.\n";
+    }
+    std::terminate();
+  }
+
+  std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
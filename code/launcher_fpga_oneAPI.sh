@@ -12,12 +12,49 @@ EXAMPLES=( 01-no_data_alignment
 	   06-shift_register  
 	   08-vector_add_ndrange_profiling_simd
 	   09-loop_unroll
-	   10-alignment )
+	   10-alignment
+	   12-multi_device_partitioner
+	   13-multi_device_migration
+	   14-convolution_engine
+	   15-image_pipeline
+	   16-transpose_engine
+	   17-blas1
+	   18-outer_product
+	   19-streaming_framework
+	   20-host_pipe_latency
+	   21-persistent_kernel
+	   22-launch_overhead
+	   23-command_graph
+	   24-async_tasks
+	   25-out_of_order
+	   26-compute_units
+	   27-memory_banks
+	   28-lsu_control
+	   29-variant_sweep
+	   30-device_link )
 
 
 
 
 for code in "${EXAMPLES[@]}"; do
+EXTRA_MODULES=""
+EXTRA_FLAGS=""
+BUILD_STEP="Building fpga image"
+PREPARE_BUILD="mkdir -p build && find build -mindepth 1 -delete && cd build"
+if [[ "${code}" == "14-convolution_engine" ]];then
+	EXTRA_MODULES="OpenCV"
+	EXTRA_FLAGS="-DUSER_FLAGS=\"-lopencv_core -lopencv_imgcodecs -lopencv_highgui -lopencv_imgproc\" "
+fi
+BUILD_CMD="cmake -DUSER_FPGA_FLAGS=\"-Xsfast-compile -Xsparallel=128\" ${EXTRA_FLAGS}.. && make VERBOSE=3 fpga"
+if [[ "${code}" == "29-variant_sweep" ]];then
+	# reports only, one per variant, built in parallel
+	BUILD_STEP="Building the early-image report of every variant"
+	BUILD_CMD='cmake .. && make -j ${SLURM_CPUS_PER_TASK} sweep_results'
+fi
+if [[ "${code}" == "30-device_link" ]];then
+	PREPARE_BUILD="# kept between runs: after a host-only change, make fpga only re-links
+mkdir -p build && cd build"
+fi
 
 DIR=$(find $PWD -name "$code")
 LAUNCHER="launcher_${code}.sh"
@@ -34,14 +71,14 @@ cat << EOF > ${LAUNCHER}
 
 module --force purge
 module load env/staging/2023.1
-module load CMake
+module load CMake ${EXTRA_MODULES}
 module load intel-oneapi/2024.1.0
 module load 520nmx/20.4
 
 echo "Create building directory"
-mkdir -p build && find build -mindepth 1 -delete && cd build
-echo "Building fpga image"
-cmake -DUSER_FPGA_FLAGS="-Xsfast-compile -Xsparallel=128" .. && make VERBOSE=3 fpga
+${PREPARE_BUILD}
+echo "${BUILD_STEP}"
+${BUILD_CMD}
 EOF
 chmod +x ${LAUNCHER}
 cat ${LAUNCHER}